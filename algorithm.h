@@ -0,0 +1,848 @@
+#ifndef TINYSTL_ALGORITHM_H
+#define TINYSTL_ALGORITHM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "allocator.h"
+#include "iterator.h"
+
+namespace tinystl{
+    //below this size quicksort/merge sort fall back to insertion sort
+    constexpr ptrdiff_t k_insertion_sort_threshold = 24;
+    //above this size pdqsort takes a pseudo median of nine as pivot
+    constexpr ptrdiff_t k_ninther_threshold = 128;
+    //max element moves partial_insertion_sort may do before giving up
+    constexpr ptrdiff_t k_partial_insertion_sort_limit = 8;
+    //below this size radix sort loses to pdqsort
+    constexpr ptrdiff_t k_radix_sort_threshold = 256;
+    //below this size parallel_sort does not spawn threads
+    constexpr ptrdiff_t k_parallel_sort_threshold = 1 << 16;
+
+    //owns n elements moved out of a range, used as scratch space by the sorts
+    template<typename T>
+    class temporary_buffer{
+    public:
+        using allocator_type = Allocator<T>;
+
+        template<typename Iterator>
+        temporary_buffer(Iterator first, Iterator last, size_t n):
+        data_(allocator_type::allocate(n)), size_(0)
+        {
+            for(; first != last; ++first, ++size_)
+            {
+                allocator_type::construct(data_ + size_, std::move(*first));
+            }
+        }
+
+        temporary_buffer(const temporary_buffer&) = delete;
+        temporary_buffer& operator=(const temporary_buffer&) = delete;
+
+        ~temporary_buffer()
+        {
+            for(size_t i = 0; i < size_; i++)
+            {
+                allocator_type::destroy(data_ + i);
+            }
+            allocator_type::deallocate(data_, size_);
+        }
+
+        inline T* begin() noexcept{return data_;}
+        inline T* end() noexcept{return data_ + size_;}
+        inline size_t size() const noexcept{return size_;}
+
+    private:
+        T* data_;
+        size_t size_;
+    };
+
+    //---------------------------------------------------------------
+    //insertion sort
+
+    template<typename RandomIterator, typename Compare>
+    void insertion_sort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        if(first == last)
+        {
+            return;
+        }
+        for(RandomIterator cur = first + 1; cur != last; ++cur)
+        {
+            RandomIterator sift = cur;
+            RandomIterator sift_1 = cur - 1;
+            if(comp(*sift, *sift_1))
+            {
+                T tmp = std::move(*sift);
+                do
+                {
+                    *sift-- = std::move(*sift_1);
+                }while(sift != first && comp(tmp, *--sift_1));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+    //requires *(first - 1) to be no greater than any element of the range
+    template<typename RandomIterator, typename Compare>
+    void unguarded_insertion_sort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        if(first == last)
+        {
+            return;
+        }
+        for(RandomIterator cur = first + 1; cur != last; ++cur)
+        {
+            RandomIterator sift = cur;
+            RandomIterator sift_1 = cur - 1;
+            if(comp(*sift, *sift_1))
+            {
+                T tmp = std::move(*sift);
+                do
+                {
+                    *sift-- = std::move(*sift_1);
+                }while(comp(tmp, *--sift_1));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+    //insertion sort that gives up after k_partial_insertion_sort_limit moves,
+    //returns whether the range ended up sorted
+    template<typename RandomIterator, typename Compare>
+    bool partial_insertion_sort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        if(first == last)
+        {
+            return true;
+        }
+        ptrdiff_t limit = 0;
+        for(RandomIterator cur = first + 1; cur != last; ++cur)
+        {
+            RandomIterator sift = cur;
+            RandomIterator sift_1 = cur - 1;
+            if(comp(*sift, *sift_1))
+            {
+                T tmp = std::move(*sift);
+                do
+                {
+                    *sift-- = std::move(*sift_1);
+                }while(sift != first && comp(tmp, *--sift_1));
+                *sift = std::move(tmp);
+                limit += cur - sift;
+            }
+            if(limit > k_partial_insertion_sort_limit)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------
+    //heap sort, partial sort
+
+    //max heap of len elements rooted at first, restores the heap below hole
+    template<typename RandomIterator, typename Distance, typename Compare>
+    void sift_down(RandomIterator first, Distance hole, Distance len, Compare comp)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        T value = std::move(first[hole]);
+        Distance child = 2 * hole + 1;
+        while(child < len)
+        {
+            if(child + 1 < len && comp(first[child], first[child + 1]))
+            {
+                ++child;
+            }
+            if(!comp(value, first[child]))
+            {
+                break;
+            }
+            first[hole] = std::move(first[child]);
+            hole = child;
+            child = 2 * hole + 1;
+        }
+        first[hole] = std::move(value);
+    }
+
+    template<typename RandomIterator, typename Distance, typename Compare>
+    void build_heap(RandomIterator first, Distance len, Compare comp)
+    {
+        for(Distance i = len / 2; i > 0; i--)
+        {
+            sift_down(first, i - 1, len, comp);
+        }
+    }
+
+    template<typename RandomIterator, typename Distance, typename Compare>
+    void sort_heap(RandomIterator first, Distance len, Compare comp)
+    {
+        for(; len > 1; len--)
+        {
+            std::iter_swap(first, first + (len - 1));
+            sift_down(first, Distance(0), len - 1, comp);
+        }
+    }
+
+    template<typename RandomIterator, typename Compare>
+    void heap_sort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        typename iterator_trait<RandomIterator>::difference_type len = last - first;
+        build_heap(first, len, comp);
+        sort_heap(first, len, comp);
+    }
+
+    //---------------------------------------------------------------
+    //pattern defeating quicksort
+
+    template<typename RandomIterator, typename Compare>
+    inline void sort2(RandomIterator a, RandomIterator b, Compare comp)
+    {
+        if(comp(*b, *a))
+        {
+            std::iter_swap(a, b);
+        }
+    }
+
+    template<typename RandomIterator, typename Compare>
+    inline void sort3(RandomIterator a, RandomIterator b, RandomIterator c, Compare comp)
+    {
+        sort2(a, b, comp);
+        sort2(b, c, comp);
+        sort2(a, b, comp);
+    }
+
+    //partitions around *first, elements equal to the pivot go right.
+    //returns the pivot position and whether the range was already partitioned
+    template<typename RandomIterator, typename Compare>
+    std::pair<RandomIterator, bool> pdq_partition_right(RandomIterator begin, RandomIterator end, Compare comp)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        T pivot = std::move(*begin);
+        RandomIterator first = begin;
+        RandomIterator last = end;
+
+        //the pivot was chosen as a median, so an element >= pivot exists on the right
+        while(comp(*++first, pivot));
+
+        if(first - 1 == begin)
+        {
+            while(first < last && !comp(*--last, pivot));
+        }
+        else
+        {
+            while(!comp(*--last, pivot));
+        }
+
+        bool already_partitioned = first >= last;
+        while(first < last)
+        {
+            std::iter_swap(first, last);
+            while(comp(*++first, pivot));
+            while(!comp(*--last, pivot));
+        }
+
+        RandomIterator pivot_pos = first - 1;
+        *begin = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return {pivot_pos, already_partitioned};
+    }
+
+    //partitions around *first, elements equal to the pivot go left.
+    //used when the pivot equals the element before the range, so the whole
+    //left part is made of pivot copies and needs no further sorting
+    template<typename RandomIterator, typename Compare>
+    RandomIterator pdq_partition_left(RandomIterator begin, RandomIterator end, Compare comp)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        T pivot = std::move(*begin);
+        RandomIterator first = begin;
+        RandomIterator last = end;
+
+        while(comp(pivot, *--last));
+
+        if(last + 1 == end)
+        {
+            while(first < last && !comp(pivot, *++first));
+        }
+        else
+        {
+            while(!comp(pivot, *++first));
+        }
+
+        while(first < last)
+        {
+            std::iter_swap(first, last);
+            while(comp(pivot, *--last));
+            while(!comp(pivot, *++first));
+        }
+
+        RandomIterator pivot_pos = last;
+        *begin = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return pivot_pos;
+    }
+
+    template<typename RandomIterator, typename Compare>
+    void pdqsort_loop(RandomIterator begin, RandomIterator end, Compare comp, int bad_allowed, bool leftmost)
+    {
+        using Distance = typename iterator_trait<RandomIterator>::difference_type;
+        while(true)
+        {
+            Distance size = end - begin;
+            if(size < k_insertion_sort_threshold)
+            {
+                if(leftmost)
+                {
+                    insertion_sort(begin, end, comp);
+                }
+                else
+                {
+                    unguarded_insertion_sort(begin, end, comp);
+                }
+                return;
+            }
+
+            //pivot ends up in *begin
+            Distance s2 = size / 2;
+            if(size > k_ninther_threshold)
+            {
+                sort3(begin, begin + s2, end - 1, comp);
+                sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+                sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+                sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+                std::iter_swap(begin, begin + s2);
+            }
+            else
+            {
+                sort3(begin + s2, begin, end - 1, comp);
+            }
+
+            //many equal elements: the previous pivot equals this one
+            if(!leftmost && !comp(*(begin - 1), *begin))
+            {
+                begin = pdq_partition_left(begin, end, comp) + 1;
+                continue;
+            }
+
+            std::pair<RandomIterator, bool> part = pdq_partition_right(begin, end, comp);
+            RandomIterator pivot_pos = part.first;
+            Distance l_size = pivot_pos - begin;
+            Distance r_size = end - (pivot_pos + 1);
+
+            if(l_size < size / 8 || r_size < size / 8)
+            {
+                //too many bad partitions, O(n log n) is guaranteed by heap sort
+                if(--bad_allowed == 0)
+                {
+                    heap_sort(begin, end, comp);
+                    return;
+                }
+
+                //break up the pattern that produced the bad pivot
+                if(l_size >= k_insertion_sort_threshold)
+                {
+                    std::iter_swap(begin, begin + l_size / 4);
+                    std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    if(l_size > k_ninther_threshold)
+                    {
+                        std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                        std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                        std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                        std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                    }
+                }
+                if(r_size >= k_insertion_sort_threshold)
+                {
+                    std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                    std::iter_swap(end - 1, end - r_size / 4);
+                    if(r_size > k_ninther_threshold)
+                    {
+                        std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                        std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                        std::iter_swap(end - 2, end - (1 + r_size / 4));
+                        std::iter_swap(end - 3, end - (2 + r_size / 4));
+                    }
+                }
+            }
+            else if(part.second
+                && partial_insertion_sort(begin, pivot_pos, comp)
+                && partial_insertion_sort(pivot_pos + 1, end, comp))
+            {
+                //the range looked sorted and it was
+                return;
+            }
+
+            pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost);
+            begin = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+
+    template<typename RandomIterator, typename Compare>
+    void pdqsort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        if(last - first < 2)
+        {
+            return;
+        }
+        int log2 = 0;
+        for(auto n = last - first; n > 1; n >>= 1)
+        {
+            ++log2;
+        }
+        pdqsort_loop(first, last, comp, log2, true);
+    }
+
+    //---------------------------------------------------------------
+    //LSD radix sort
+
+    //integral (except bool) and IEEE float keys up to 64 bits can be radix
+    //sorted, gnu++ counts __int128 as integral
+    template<typename T>
+    struct is_radix_sortable
+    : public m_bool_constant<(std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 8)
+        || std::is_same<T, float>::value || std::is_same<T, double>::value>{};
+
+    //maps a key to an unsigned integer with the same ordering
+    template<typename T>
+    struct radix_key{
+        using type = typename std::conditional<sizeof(T) == 1, uint8_t,
+            typename std::conditional<sizeof(T) == 2, uint16_t,
+            typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type;
+
+        static constexpr type k_sign_bit = type(1) << (sizeof(T) * 8 - 1);
+
+        static inline type get(T value)
+        {
+            type key;
+            std::memcpy(&key, &value, sizeof(T));
+            if constexpr(std::is_floating_point<T>::value)
+            {
+                //-0.0 compares equal to +0.0 and must get the same key, or
+                //stable_sort would reorder them
+                if(value == T(0))
+                {
+                    return k_sign_bit;
+                }
+                //negative floats sort reversed, so flip all their bits
+                return (key & k_sign_bit) ? type(~key) : type(key ^ k_sign_bit);
+            }
+            else if constexpr(std::is_signed<T>::value)
+            {
+                return key ^ k_sign_bit;
+            }
+            else
+            {
+                return key;
+            }
+        }
+    };
+
+    template<typename InputIterator, typename OutputIterator>
+    void radix_scatter(InputIterator src, OutputIterator dst, size_t n, size_t* offset, int shift)
+    {
+        using T = typename iterator_trait<InputIterator>::value_type;
+        for(size_t i = 0; i < n; i++)
+        {
+            size_t byte = (radix_key<T>::get(src[i]) >> shift) & 0xff;
+            dst[offset[byte]++] = src[i];
+        }
+    }
+
+    //stable, sorts ascending, one pass per key byte
+    template<typename RandomIterator>
+    void radix_sort(RandomIterator first, RandomIterator last)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        static_assert(is_radix_sortable<T>::value, "radix_sort requires integral or floating point keys");
+        constexpr size_t k_passes = sizeof(T);
+
+        size_t n = last - first;
+        if(n < 2)
+        {
+            return;
+        }
+
+        //histograms of every byte are built in a single read of the input,
+        //which also tells whether the input is already sorted
+        size_t counts[k_passes][256] = {};
+        bool sorted = true;
+        typename radix_key<T>::type prev_key = 0;
+        for(size_t i = 0; i < n; i++)
+        {
+            typename radix_key<T>::type key = radix_key<T>::get(first[i]);
+            sorted = sorted && prev_key <= key;
+            prev_key = key;
+            for(size_t p = 0; p < k_passes; p++)
+            {
+                ++counts[p][(key >> (p * 8)) & 0xff];
+            }
+        }
+        if(sorted)
+        {
+            return;
+        }
+
+        T* buffer = Allocator<T>::allocate(n);
+        bool in_buffer = false;
+        typename radix_key<T>::type first_key = radix_key<T>::get(first[0]);
+        for(size_t p = 0; p < k_passes; p++)
+        {
+            //every key shares this byte, the pass would be an identity copy
+            if(counts[p][(first_key >> (p * 8)) & 0xff] == n)
+            {
+                continue;
+            }
+            size_t offset[256];
+            size_t sum = 0;
+            for(size_t b = 0; b < 256; b++)
+            {
+                offset[b] = sum;
+                sum += counts[p][b];
+            }
+            if(in_buffer)
+            {
+                radix_scatter(buffer, first, n, offset, static_cast<int>(p * 8));
+            }
+            else
+            {
+                radix_scatter(first, buffer, n, offset, static_cast<int>(p * 8));
+            }
+            in_buffer = !in_buffer;
+        }
+        if(in_buffer)
+        {
+            std::copy(buffer, buffer + n, first);
+        }
+        Allocator<T>::deallocate(buffer, n);
+    }
+
+    //---------------------------------------------------------------
+    //merge sort
+
+    template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Compare>
+    OutputIterator merge_move(InputIterator1 first1, InputIterator1 last1,
+        InputIterator2 first2, InputIterator2 last2, OutputIterator out, Compare comp)
+    {
+        while(first1 != last1 && first2 != last2)
+        {
+            //take from the right run only when strictly smaller, keeps it stable
+            if(comp(*first2, *first1))
+            {
+                *out = std::move(*first2);
+                ++first2;
+            }
+            else
+            {
+                *out = std::move(*first1);
+                ++first1;
+            }
+            ++out;
+        }
+        out = std::move(first1, last1, out);
+        return std::move(first2, last2, out);
+    }
+
+    //merges adjacent runs of width elements from src into dst
+    template<typename InputIterator, typename OutputIterator, typename Compare>
+    void merge_pass(InputIterator src, OutputIterator dst, ptrdiff_t n, ptrdiff_t width, Compare comp)
+    {
+        for(ptrdiff_t lo = 0; lo < n; lo += 2 * width)
+        {
+            ptrdiff_t mid = std::min(lo + width, n);
+            ptrdiff_t hi = std::min(lo + 2 * width, n);
+            merge_move(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+        }
+    }
+
+    //bottom up merge sort ping-ponging between the range and one buffer
+    template<typename RandomIterator, typename Compare>
+    void merge_sort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        ptrdiff_t n = last - first;
+        for(ptrdiff_t lo = 0; lo < n; lo += k_insertion_sort_threshold)
+        {
+            insertion_sort(first + lo, first + std::min(lo + k_insertion_sort_threshold, n), comp);
+        }
+        if(n <= k_insertion_sort_threshold)
+        {
+            return;
+        }
+
+        temporary_buffer<T> buffer(first, last, n);
+        //the buffer now holds the data, the range is scratch
+        bool in_buffer = true;
+        for(ptrdiff_t width = k_insertion_sort_threshold; width < n; width *= 2)
+        {
+            if(in_buffer)
+            {
+                merge_pass(buffer.begin(), first, n, width, comp);
+            }
+            else
+            {
+                merge_pass(first, buffer.begin(), n, width, comp);
+            }
+            in_buffer = !in_buffer;
+        }
+        if(in_buffer)
+        {
+            std::move(buffer.begin(), buffer.end(), first);
+        }
+    }
+
+    //---------------------------------------------------------------
+    //dispatch on iterator_category
+
+    //radix sort is only picked when the comparator is the natural order
+    template<typename RandomIterator, typename Compare>
+    inline constexpr bool k_use_radix_sort =
+        is_radix_sortable<typename iterator_trait<RandomIterator>::value_type>::value &&
+        std::is_same<Compare, std::less<typename iterator_trait<RandomIterator>::value_type>>::value;
+
+    template<typename RandomIterator, typename Compare>
+    void sort_dispatch(RandomIterator first, RandomIterator last, Compare comp, random_access_iterator_tag)
+    {
+        if constexpr(k_use_radix_sort<RandomIterator, Compare>)
+        {
+            if(last - first >= k_radix_sort_threshold)
+            {
+                radix_sort(first, last);
+                return;
+            }
+        }
+        pdqsort(first, last, comp);
+    }
+
+    //node based ranges are sorted in a contiguous copy and moved back
+    template<typename ForwardIterator, typename Compare>
+    void sort_dispatch(ForwardIterator first, ForwardIterator last, Compare comp, forward_iterator_tag)
+    {
+        using T = typename iterator_trait<ForwardIterator>::value_type;
+        temporary_buffer<T> buffer(first, last, tinystl::distance(first, last));
+        sort_dispatch(buffer.begin(), buffer.end(), comp, random_access_iterator_tag());
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+
+    template<typename RandomIterator, typename Compare>
+    void stable_sort_dispatch(RandomIterator first, RandomIterator last, Compare comp, random_access_iterator_tag)
+    {
+        if constexpr(k_use_radix_sort<RandomIterator, Compare>)
+        {
+            if(last - first >= k_radix_sort_threshold)
+            {
+                radix_sort(first, last);
+                return;
+            }
+        }
+        merge_sort(first, last, comp);
+    }
+
+    template<typename ForwardIterator, typename Compare>
+    void stable_sort_dispatch(ForwardIterator first, ForwardIterator last, Compare comp, forward_iterator_tag)
+    {
+        using T = typename iterator_trait<ForwardIterator>::value_type;
+        temporary_buffer<T> buffer(first, last, tinystl::distance(first, last));
+        stable_sort_dispatch(buffer.begin(), buffer.end(), comp, random_access_iterator_tag());
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+
+    template<typename RandomIterator, typename Compare>
+    void partial_sort_dispatch(RandomIterator first, RandomIterator middle, RandomIterator last,
+        Compare comp, random_access_iterator_tag)
+    {
+        typename iterator_trait<RandomIterator>::difference_type len = middle - first;
+        if(len == 0)
+        {
+            return;
+        }
+        //keep the len smallest elements in a max heap
+        build_heap(first, len, comp);
+        for(RandomIterator it = middle; it < last; ++it)
+        {
+            if(comp(*it, *first))
+            {
+                std::iter_swap(it, first);
+                sift_down(first, decltype(len)(0), len, comp);
+            }
+        }
+        sort_heap(first, len, comp);
+    }
+
+    template<typename ForwardIterator, typename Compare>
+    void partial_sort_dispatch(ForwardIterator first, ForwardIterator middle, ForwardIterator last,
+        Compare comp, forward_iterator_tag)
+    {
+        using T = typename iterator_trait<ForwardIterator>::value_type;
+        auto len = tinystl::distance(first, middle);
+        temporary_buffer<T> buffer(first, last, tinystl::distance(first, last));
+        partial_sort_dispatch(buffer.begin(), buffer.begin() + len, buffer.end(), comp, random_access_iterator_tag());
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+
+    //not stable. integral and floating keys with the default order use
+    //radix sort, everything else pattern defeating quicksort
+    template<typename Iterator, typename Compare>
+    void sort(Iterator first, Iterator last, Compare comp)
+    {
+        sort_dispatch(first, last, comp, iterator_category(first));
+    }
+
+    template<typename Iterator>
+    void sort(Iterator first, Iterator last)
+    {
+        tinystl::sort(first, last, std::less<typename iterator_trait<Iterator>::value_type>());
+    }
+
+    template<typename Iterator, typename Compare>
+    void stable_sort(Iterator first, Iterator last, Compare comp)
+    {
+        stable_sort_dispatch(first, last, comp, iterator_category(first));
+    }
+
+    template<typename Iterator>
+    void stable_sort(Iterator first, Iterator last)
+    {
+        tinystl::stable_sort(first, last, std::less<typename iterator_trait<Iterator>::value_type>());
+    }
+
+    //sorts the middle - first smallest elements into [first, middle),
+    //the order of [middle, last) is unspecified
+    template<typename Iterator, typename Compare>
+    void partial_sort(Iterator first, Iterator middle, Iterator last, Compare comp)
+    {
+        partial_sort_dispatch(first, middle, last, comp, iterator_category(first));
+    }
+
+    template<typename Iterator>
+    void partial_sort(Iterator first, Iterator middle, Iterator last)
+    {
+        tinystl::partial_sort(first, middle, last, std::less<typename iterator_trait<Iterator>::value_type>());
+    }
+
+    //---------------------------------------------------------------
+    //parallel merge sort
+
+    //sorts one chunk per thread then merges pairs of chunks in parallel rounds
+    template<typename RandomIterator, typename Compare>
+    void parallel_sort_impl(RandomIterator first, RandomIterator last, Compare comp, bool stable)
+    {
+        using T = typename iterator_trait<RandomIterator>::value_type;
+        ptrdiff_t n = last - first;
+        ptrdiff_t chunks = 1;
+        while(chunks * 2 <= static_cast<ptrdiff_t>(std::thread::hardware_concurrency())
+            && n / (chunks * 2) >= k_parallel_sort_threshold / 2)
+        {
+            chunks *= 2;
+        }
+        if(chunks == 1)
+        {
+            if(stable)
+            {
+                tinystl::stable_sort(first, last, comp);
+            }
+            else
+            {
+                tinystl::sort(first, last, comp);
+            }
+            return;
+        }
+
+        std::vector<ptrdiff_t> bounds(chunks + 1);
+        for(ptrdiff_t i = 0; i <= chunks; i++)
+        {
+            bounds[i] = n * i / chunks;
+        }
+
+        std::vector<std::thread> workers;
+        for(ptrdiff_t i = 0; i < chunks; i++)
+        {
+            RandomIterator lo = first + bounds[i];
+            RandomIterator hi = first + bounds[i + 1];
+            workers.emplace_back([=]{
+                if(stable)
+                {
+                    tinystl::stable_sort(lo, hi, comp);
+                }
+                else
+                {
+                    tinystl::sort(lo, hi, comp);
+                }
+            });
+        }
+        for(std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        temporary_buffer<T> buffer(first, last, n);
+        T* scratch = buffer.begin();
+        bool in_buffer = true;
+        for(ptrdiff_t step = 1; step < chunks; step *= 2)
+        {
+            workers.clear();
+            for(ptrdiff_t i = 0; i + step < chunks; i += 2 * step)
+            {
+                ptrdiff_t lo = bounds[i];
+                ptrdiff_t mid = bounds[i + step];
+                ptrdiff_t hi = bounds[std::min(i + 2 * step, chunks)];
+                workers.emplace_back([=]{
+                    if(in_buffer)
+                    {
+                        merge_move(scratch + lo, scratch + mid, scratch + mid, scratch + hi, first + lo, comp);
+                    }
+                    else
+                    {
+                        merge_move(first + lo, first + mid, first + mid, first + hi, scratch + lo, comp);
+                    }
+                });
+            }
+            for(std::thread& worker : workers)
+            {
+                worker.join();
+            }
+            in_buffer = !in_buffer;
+        }
+        if(in_buffer)
+        {
+            std::move(buffer.begin(), buffer.end(), first);
+        }
+    }
+
+    template<typename RandomIterator, typename Compare>
+    void parallel_sort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        parallel_sort_impl(first, last, comp, false);
+    }
+
+    template<typename RandomIterator>
+    void parallel_sort(RandomIterator first, RandomIterator last)
+    {
+        parallel_sort_impl(first, last, std::less<typename iterator_trait<RandomIterator>::value_type>(), false);
+    }
+
+    template<typename RandomIterator, typename Compare>
+    void parallel_stable_sort(RandomIterator first, RandomIterator last, Compare comp)
+    {
+        parallel_sort_impl(first, last, comp, true);
+    }
+
+    template<typename RandomIterator>
+    void parallel_stable_sort(RandomIterator first, RandomIterator last)
+    {
+        parallel_sort_impl(first, last, std::less<typename iterator_trait<RandomIterator>::value_type>(), true);
+    }
+}
+
+#endif //TINYSTL_ALGORITHM_H
@@ -2,6 +2,7 @@
 #define TINYSTL_ALLOCATOR_H
 
 #include <iostream>
+#include <utility>
 
 namespace tinystl
 {
@@ -56,14 +57,14 @@ namespace tinystl
     template<typename T>
     void Allocator<T>::construct(pointer p, T&& q)
     {
-        new(p) T(q);
+        new(p) T(std::move(q));
     }
 
     template<typename T>
     template<class... Args>
     void Allocator<T>::construct(pointer p, Args&&... args)
     {
-        new(p) T(std::forward(args)...);
+        new(p) T(std::forward<Args>(args)...);
     }
 
     template<typename T>
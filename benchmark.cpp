@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "algorithm.h"
+#include "coroutine.h"
+#include "epoch.h"
+#include "memory.h"
+
+//milliseconds spent in one call of f
+template<typename F>
+double time_ms(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::vector<uint64_t> make_input(size_t n, const char* pattern)
+{
+    std::mt19937_64 rng(n);
+    std::vector<uint64_t> v(n);
+    for(size_t i = 0; i < n; i++)
+    {
+        if(std::strcmp(pattern, "random") == 0) v[i] = rng();
+        else if(std::strcmp(pattern, "sorted") == 0) v[i] = i;
+        else if(std::strcmp(pattern, "reverse") == 0) v[i] = n - i;
+        else v[i] = rng() % 16;
+    }
+    return v;
+}
+
+template<typename Sort>
+void run_sort(const char* name, const std::vector<uint64_t>& input, Sort sort)
+{
+    std::vector<uint64_t> v = input;
+    double ms = time_ms([&]{sort(v.data(), v.data() + v.size());});
+    if(!std::is_sorted(v.begin(), v.end()))
+    {
+        std::cout << name << " FAILED\n";
+        std::exit(1);
+    }
+    std::cout << "  " << name << ": " << ms << " ms\n";
+}
+
+void bench_sort(size_t max_n)
+{
+    //a comparator other than std::less keeps tinystl::sort off the radix path
+    auto less = [](uint64_t a, uint64_t b){return a < b;};
+    const char* patterns[] = {"random", "sorted", "reverse", "duplicates"};
+    for(size_t n = 1000; n <= max_n; n *= 10)
+    {
+        for(const char* pattern : patterns)
+        {
+            std::vector<uint64_t> input = make_input(n, pattern);
+            std::cout << "sort n=" << n << " " << pattern << "\n";
+            run_sort("std::sort", input, [](uint64_t* f, uint64_t* l){std::sort(f, l);});
+            run_sort("tinystl::sort (radix)", input, [](uint64_t* f, uint64_t* l){tinystl::sort(f, l);});
+            run_sort("tinystl::sort (pdqsort)", input, [&](uint64_t* f, uint64_t* l){tinystl::sort(f, l, less);});
+            run_sort("std::stable_sort", input, [](uint64_t* f, uint64_t* l){std::stable_sort(f, l);});
+            run_sort("tinystl::stable_sort (merge)", input, [&](uint64_t* f, uint64_t* l){tinystl::stable_sort(f, l, less);});
+            run_sort("tinystl::parallel_sort", input, [&](uint64_t* f, uint64_t* l){tinystl::parallel_sort(f, l, less);});
+        }
+    }
+}
+
+//minimal coroutine whose frame lives on the global heap, the baseline for frame_pool
+struct heap_coroutine{
+    struct promise_type{
+        heap_coroutine get_return_object(){return {std::coroutine_handle<promise_type>::from_promise(*this)};}
+        std::suspend_always initial_suspend() noexcept{return {};}
+        std::suspend_always final_suspend() noexcept{return {};}
+        void return_void(){}
+        void unhandled_exception(){std::terminate();}
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+//same coroutine with its frame taken from tinystl::frame_pool
+struct pooled_coroutine{
+    struct promise_type: public tinystl::pooled_promise{
+        pooled_coroutine get_return_object(){return {std::coroutine_handle<promise_type>::from_promise(*this)};}
+        std::suspend_always initial_suspend() noexcept{return {};}
+        std::suspend_always final_suspend() noexcept{return {};}
+        void return_void(){}
+        void unhandled_exception(){std::terminate();}
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+template<typename Coroutine>
+Coroutine add_one(uint64_t& sum)
+{
+    ++sum;
+    co_return;
+}
+
+tinystl::generator<uint64_t> count_to(uint64_t n)
+{
+    for(uint64_t i = 0; i < n; i++)
+    {
+        co_yield i;
+    }
+}
+
+//symmetric transfer keeps the stack flat only once the compiler turns it
+//into a tail call, which needs optimization and no address sanitizer.
+//otherwise every co_await in the chain costs a stack frame
+#if defined(__SANITIZE_ADDRESS__) || !defined(__OPTIMIZE__)
+constexpr bool k_flat_await_stack = false;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+constexpr bool k_flat_await_stack = false;
+#else
+constexpr bool k_flat_await_stack = true;
+#endif
+#else
+constexpr bool k_flat_await_stack = true;
+#endif
+
+tinystl::task<uint64_t> await_chain(uint64_t depth)
+{
+    if(depth == 0)
+    {
+        co_return 0;
+    }
+    co_return 1 + co_await await_chain(depth - 1);
+}
+
+template<typename Coroutine>
+void run_frames(const char* name, size_t n)
+{
+    uint64_t sum = 0;
+    double ms = time_ms([&]{
+        for(size_t i = 0; i < n; i++)
+        {
+            Coroutine c = add_one<Coroutine>(sum);
+            c.handle.resume();
+            c.handle.destroy();
+        }
+    });
+    std::cout << "  " << name << ": " << ms * 1e6 / n << " ns per frame\n";
+}
+
+void bench_coroutine()
+{
+    const size_t n = 1000000;
+    std::cout << "coroutine frame create/resume/destroy n=" << n << "\n";
+    run_frames<heap_coroutine>("global heap", n);
+    run_frames<pooled_coroutine>("tinystl::frame_pool", n);
+
+    uint64_t sum = 0;
+    double ms = time_ms([&]{
+        for(uint64_t v : count_to(n))
+        {
+            sum += v;
+        }
+    });
+    std::cout << "generator pull n=" << n << ": " << ms * 1e6 / n << " ns per value\n";
+
+    uint64_t depth = 0;
+    const uint64_t max_depth = k_flat_await_stack ? n : 1000;
+    ms = time_ms([&]{depth = tinystl::sync_wait(await_chain(max_depth));});
+    std::cout << "task await chain depth=" << depth << ": " << ms << " ms\n";
+}
+
+//read mostly snapshot, replaced now and then by a writer
+struct snapshot{
+    uint64_t values[8];
+};
+
+//runs readers threads doing reads_per_thread calls of read while one writer
+//keeps calling write, returns million reads per second
+template<typename Read, typename Write>
+double run_readers(size_t readers, size_t reads_per_thread, Read read, Write write)
+{
+    std::atomic<bool> stop{false};
+    std::thread writer([&]{
+        while(!stop.load(std::memory_order_relaxed))
+        {
+            write();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    std::atomic<uint64_t> sink{0};
+    double ms = time_ms([&]{
+        std::vector<std::thread> threads;
+        for(size_t t = 0; t < readers; t++)
+        {
+            threads.emplace_back([&]{
+                uint64_t sum = 0;
+                for(size_t i = 0; i < reads_per_thread; i++)
+                {
+                    sum += read(i);
+                }
+                sink += sum;
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    });
+    stop = true;
+    writer.join();
+    return readers * reads_per_thread / ms / 1000.0;
+}
+
+void bench_reclamation()
+{
+    const size_t reads = 2000000;
+
+    std::atomic<snapshot*> epoch_current{new snapshot{}};
+    auto epoch_read = [&](size_t i){
+        tinystl::epoch_guard guard;
+        return epoch_current.load(std::memory_order_acquire)->values[i & 7];
+    };
+    auto epoch_write = [&]{
+        snapshot* old = epoch_current.exchange(new snapshot{}, std::memory_order_acq_rel);
+        tinystl::epoch_domain::global().retire(old);
+    };
+
+    //tinystl::shared_ptr counts are not atomic, readers have to serialize
+    std::mutex shared_mutex;
+    tinystl::shared_ptr<snapshot> shared_current = tinystl::make_shared<snapshot>();
+    auto shared_read = [&](size_t i){
+        std::lock_guard<std::mutex> lock(shared_mutex);
+        tinystl::shared_ptr<snapshot> local = shared_current;
+        return local->values[i & 7];
+    };
+    auto shared_write = [&]{
+        tinystl::shared_ptr<snapshot> next = tinystl::make_shared<snapshot>();
+        std::lock_guard<std::mutex> lock(shared_mutex);
+        shared_current = std::move(next);
+    };
+
+    //atomic counts, every read still bumps the same counter
+    std::shared_ptr<snapshot> std_current = std::make_shared<snapshot>();
+    auto std_read = [&](size_t i){
+        std::shared_ptr<snapshot> local = std::atomic_load(&std_current);
+        return local->values[i & 7];
+    };
+    auto std_write = [&]{
+        std::atomic_store(&std_current, std::make_shared<snapshot>());
+    };
+
+    for(size_t readers = 1; readers <= 8; readers *= 2)
+    {
+        std::cout << "read-mostly snapshot readers=" << readers << "\n";
+        std::cout << "  epoch_guard: " << run_readers(readers, reads, epoch_read, epoch_write) << " Mreads/s\n";
+        std::cout << "  tinystl::shared_ptr + mutex: " << run_readers(readers, reads, shared_read, shared_write) << " Mreads/s\n";
+        std::cout << "  std::shared_ptr atomic_load: " << run_readers(readers, reads, std_read, std_write) << " Mreads/s\n";
+    }
+    tinystl::epoch_domain::global().retire(epoch_current.load());
+}
+
+//usage: TinySTLBenchmark [max_n], sizes grow by 10x from 1000 up to max_n
+int main(int argc, char **argv)
+{
+    size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    bench_sort(max_n);
+    bench_coroutine();
+    bench_reclamation();
+    return 0;
+}
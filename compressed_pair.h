@@ -0,0 +1,64 @@
+#ifndef TINYSTL_COMPRESSED_PAIR_H
+#define TINYSTL_COMPRESSED_PAIR_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace tinystl{
+    //holds one element of a compressed_pair. empty, non final types are
+    //inherited from so the empty base optimization gives them zero size.
+    //Index keeps the two bases distinct when both elements have the same type
+    template<typename T, size_t Index, bool = std::is_empty<T>::value && !std::is_final<T>::value>
+    struct compressed_pair_elem{
+        compressed_pair_elem():value_(){}
+
+        template<typename U>
+        explicit compressed_pair_elem(U&& value):value_(std::forward<U>(value)){}
+
+        inline T& get() noexcept{return value_;}
+        inline const T& get() const noexcept{return value_;}
+
+        T value_;
+    };
+
+    template<typename T, size_t Index>
+    struct compressed_pair_elem<T, Index, true>: private T{
+        compressed_pair_elem():T(){}
+
+        template<typename U>
+        explicit compressed_pair_elem(U&& value):T(std::forward<U>(value)){}
+
+        inline T& get() noexcept{return *this;}
+        inline const T& get() const noexcept{return *this;}
+    };
+
+    //pair whose empty members take no space, e.g. a stateless deleter next to
+    //a pointer is exactly pointer sized
+    template<typename T1, typename T2>
+    class compressed_pair: private compressed_pair_elem<T1, 0>, private compressed_pair_elem<T2, 1>{
+    public:
+        using first_base = compressed_pair_elem<T1, 0>;
+        using second_base = compressed_pair_elem<T2, 1>;
+
+        compressed_pair() = default;
+
+        template<typename U1, typename U2>
+        compressed_pair(U1&& first, U2&& second):
+        first_base(std::forward<U1>(first)), second_base(std::forward<U2>(second)){}
+
+        inline T1& first() noexcept{return first_base::get();}
+        inline const T1& first() const noexcept{return first_base::get();}
+        inline T2& second() noexcept{return second_base::get();}
+        inline const T2& second() const noexcept{return second_base::get();}
+
+        void swap(compressed_pair& other)
+        {
+            using std::swap;
+            swap(first(), other.first());
+            swap(second(), other.second());
+        }
+    };
+}
+
+#endif //TINYSTL_COMPRESSED_PAIR_H
@@ -0,0 +1,457 @@
+#ifndef TINYSTL_COROUTINE_H
+#define TINYSTL_COROUTINE_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "allocator.h"
+#include "iterator.h"
+
+namespace tinystl{
+    //recycles coroutine frames through per thread free lists in 64 byte size
+    //classes, so once warmed up creating a coroutine does not allocate.
+    //blocks come from Allocator and may be freed on any thread
+    class frame_pool{
+    public:
+        static constexpr size_t k_granularity = 64;
+        static constexpr size_t k_size_classes = 16;
+        //blocks kept per size class, the rest goes back to Allocator
+        static constexpr size_t k_max_cached = 256;
+
+        static void* allocate(size_t n)
+        {
+            size_t index = size_class(n);
+            if(index >= k_size_classes)
+            {
+                return allocator_type::allocate(n);
+            }
+            cache& local = local_cache();
+            free_block* block = local.heads[index];
+            if(block == nullptr)
+            {
+                return allocator_type::allocate((index + 1) * k_granularity);
+            }
+            local.heads[index] = block->next;
+            --local.counts[index];
+            return block;
+        }
+
+        static void deallocate(void* p, size_t n)
+        {
+            size_t index = size_class(n);
+            cache& local = local_cache();
+            if(index >= k_size_classes || local.counts[index] == k_max_cached)
+            {
+                allocator_type::deallocate(static_cast<unsigned char*>(p), n);
+                return;
+            }
+            free_block* block = static_cast<free_block*>(p);
+            block->next = local.heads[index];
+            local.heads[index] = block;
+            ++local.counts[index];
+        }
+
+    private:
+        using allocator_type = Allocator<unsigned char>;
+
+        struct free_block{
+            free_block* next;
+        };
+
+        struct cache{
+            free_block* heads[k_size_classes] = {};
+            size_t counts[k_size_classes] = {};
+
+            ~cache()
+            {
+                for(size_t i = 0; i < k_size_classes; i++)
+                {
+                    while(heads[i] != nullptr)
+                    {
+                        free_block* next = heads[i]->next;
+                        allocator_type::deallocate(reinterpret_cast<unsigned char*>(heads[i]), (i + 1) * k_granularity);
+                        heads[i] = next;
+                    }
+                }
+            }
+        };
+
+        static inline size_t size_class(size_t n){return (n + k_granularity - 1) / k_granularity - 1;}
+
+        static cache& local_cache()
+        {
+            thread_local cache local;
+            return local;
+        }
+    };
+
+    //gives a promise type pooled frame allocation
+    struct pooled_promise{
+        static void* operator new(size_t n){return frame_pool::allocate(n);}
+        static void operator delete(void* p, size_t n){frame_pool::deallocate(p, n);}
+    };
+
+    //---------------------------------------------------------------
+    //generator
+
+    //lazily produces values with co_yield, pulled through an input iterator
+    template<typename T>
+    class generator{
+    public:
+        struct promise_type: public pooled_promise{
+            //the yielded object stays alive while the coroutine is suspended
+            const T* value_ = nullptr;
+            std::exception_ptr exception_;
+
+            generator get_return_object(){return generator(handle_type::from_promise(*this));}
+            std::suspend_always initial_suspend() noexcept{return {};}
+            std::suspend_always final_suspend() noexcept{return {};}
+
+            std::suspend_always yield_value(const T& value) noexcept
+            {
+                value_ = std::addressof(value);
+                return {};
+            }
+
+            void return_void(){}
+            void unhandled_exception(){exception_ = std::current_exception();}
+
+            //co_await is not allowed inside a generator
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        class iterator{
+        public:
+            using iterator_category = input_iterator_tag;
+            using value_type = T;
+            using difference_type = ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator():handle_(nullptr){}
+            explicit iterator(handle_type handle):handle_(handle){}
+
+            reference operator*() const{return *handle_.promise().value_;}
+            pointer operator->() const{return handle_.promise().value_;}
+
+            iterator& operator++()
+            {
+                resume(handle_);
+                return *this;
+            }
+            void operator++(int){++*this;}
+
+            bool operator==(const iterator& other) const{return done() == other.done();}
+            bool operator!=(const iterator& other) const{return done() != other.done();}
+
+        private:
+            inline bool done() const{return !handle_ || handle_.done();}
+
+            handle_type handle_;
+        };
+
+        generator(const generator&) = delete;
+        generator& operator=(const generator&) = delete;
+
+        generator(generator&& other) noexcept:handle_(other.handle_){other.handle_ = nullptr;}
+
+        generator& operator=(generator&& other) noexcept
+        {
+            std::swap(handle_, other.handle_);
+            return *this;
+        }
+
+        ~generator()
+        {
+            if(handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        //runs the body up to the first co_yield, so call it once
+        iterator begin()
+        {
+            if(handle_)
+            {
+                resume(handle_);
+            }
+            return iterator(handle_);
+        }
+
+        iterator end(){return iterator();}
+
+    private:
+        explicit generator(handle_type handle):handle_(handle){}
+
+        static void resume(handle_type handle)
+        {
+            handle.resume();
+            if(handle.done() && handle.promise().exception_)
+            {
+                std::rethrow_exception(handle.promise().exception_);
+            }
+        }
+
+        handle_type handle_;
+    };
+
+    //---------------------------------------------------------------
+    //task
+
+    template<typename T>
+    class task;
+
+    struct task_promise_base: public pooled_promise{
+        //resumed by symmetric transfer when this task finishes
+        std::coroutine_handle<> continuation_;
+        std::exception_ptr exception_;
+
+        struct final_awaiter{
+            bool await_ready() noexcept{return false;}
+
+            //jumping to the awaiting coroutine instead of resuming it keeps
+            //the stack flat however deep the co_await chain is
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                std::coroutine_handle<> continuation = handle.promise().continuation_;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() noexcept{}
+        };
+
+        std::suspend_always initial_suspend() noexcept{return {};}
+        final_awaiter final_suspend() noexcept{return {};}
+        void unhandled_exception(){exception_ = std::current_exception();}
+    };
+
+    template<typename T>
+    struct task_promise: public task_promise_base{
+        std::optional<T> value_;
+
+        task<T> get_return_object();
+
+        template<typename U>
+        void return_value(U&& value){value_.emplace(std::forward<U>(value));}
+
+        T result()
+        {
+            if(exception_)
+            {
+                std::rethrow_exception(exception_);
+            }
+            return std::move(*value_);
+        }
+    };
+
+    template<>
+    struct task_promise<void>: public task_promise_base{
+        task<void> get_return_object();
+
+        void return_void(){}
+
+        void result()
+        {
+            if(exception_)
+            {
+                std::rethrow_exception(exception_);
+            }
+        }
+    };
+
+    //lazily started coroutine producing one T, started by co_await or sync_wait.
+    //awaiting a task resumes it by symmetric transfer, which keeps the stack
+    //flat only when the compiler emits it as a tail call (gcc and clang do at
+    //-O2, not at -O0 or under ASan). without that every nested co_await still
+    //takes a stack frame and very deep chains can overflow
+    template<typename T = void>
+    class task{
+    public:
+        using promise_type = task_promise<T>;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        struct awaiter{
+            handle_type handle_;
+
+            bool await_ready() noexcept{return !handle_ || handle_.done();}
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle_.promise().continuation_ = awaiting;
+                return handle_;
+            }
+
+            T await_resume(){return handle_.promise().result();}
+        };
+
+        explicit task(handle_type handle):handle_(handle){}
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        task(task&& other) noexcept:handle_(other.handle_){other.handle_ = nullptr;}
+
+        task& operator=(task&& other) noexcept
+        {
+            std::swap(handle_, other.handle_);
+            return *this;
+        }
+
+        ~task()
+        {
+            if(handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        awaiter operator co_await() const& noexcept{return awaiter{handle_};}
+        awaiter operator co_await() const&& noexcept{return awaiter{handle_};}
+
+    private:
+        handle_type handle_;
+    };
+
+    template<typename T>
+    task<T> task_promise<T>::get_return_object()
+    {
+        return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+    }
+
+    inline task<void> task_promise<void>::get_return_object()
+    {
+        return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+    }
+
+    //---------------------------------------------------------------
+    //sync_wait
+
+    //one shot event a blocking thread waits on, set() holds the lock while
+    //notifying so the waiter may destroy the event as soon as it returns
+    class sync_wait_event{
+    public:
+        void set()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+            cond_.notify_one();
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]{return done_;});
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        bool done_ = false;
+    };
+
+    //top level coroutine that awaits a task and signals a blocked thread
+    class sync_wait_task{
+    public:
+        struct promise_type: public pooled_promise{
+            sync_wait_event* event_ = nullptr;
+
+            struct notify_awaiter{
+                bool await_ready() noexcept{return false;}
+                void await_suspend(std::coroutine_handle<promise_type> handle) noexcept{handle.promise().event_->set();}
+                void await_resume() noexcept{}
+            };
+
+            sync_wait_task get_return_object(){return sync_wait_task(std::coroutine_handle<promise_type>::from_promise(*this));}
+            std::suspend_always initial_suspend() noexcept{return {};}
+            notify_awaiter final_suspend() noexcept{return {};}
+            void return_void(){}
+            //the body catches everything itself
+            void unhandled_exception() noexcept{std::terminate();}
+        };
+
+        explicit sync_wait_task(std::coroutine_handle<promise_type> handle):handle_(handle){}
+
+        sync_wait_task(const sync_wait_task&) = delete;
+        sync_wait_task& operator=(const sync_wait_task&) = delete;
+
+        ~sync_wait_task(){handle_.destroy();}
+
+        void start(sync_wait_event& event)
+        {
+            handle_.promise().event_ = &event;
+            handle_.resume();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    template<typename T>
+    sync_wait_task make_sync_wait_task(task<T>& t, std::optional<T>& result, std::exception_ptr& exception)
+    {
+        try
+        {
+            result.emplace(co_await t);
+        }
+        catch(...)
+        {
+            exception = std::current_exception();
+        }
+    }
+
+    inline sync_wait_task make_sync_wait_task(task<void>& t, std::exception_ptr& exception)
+    {
+        try
+        {
+            co_await t;
+        }
+        catch(...)
+        {
+            exception = std::current_exception();
+        }
+    }
+
+    //runs t to completion on the calling thread, blocking while it is
+    //suspended on work resumed elsewhere
+    template<typename T>
+    T sync_wait(task<T> t)
+    {
+        sync_wait_event event;
+        std::exception_ptr exception;
+        if constexpr(std::is_void<T>::value)
+        {
+            sync_wait_task waiter = make_sync_wait_task(t, exception);
+            waiter.start(event);
+            event.wait();
+            if(exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+        else
+        {
+            std::optional<T> result;
+            sync_wait_task waiter = make_sync_wait_task(t, result, exception);
+            waiter.start(event);
+            event.wait();
+            if(exception)
+            {
+                std::rethrow_exception(exception);
+            }
+            return std::move(*result);
+        }
+    }
+}
+
+#endif //TINYSTL_COROUTINE_H
@@ -0,0 +1,268 @@
+#ifndef TINYSTL_EPOCH_H
+#define TINYSTL_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "deleter.h"
+
+namespace tinystl{
+    //epoch based reclamation for lock free structures.
+    //readers pin the current global epoch for the duration of a critical
+    //section (epoch_guard) without touching any shared counter except their
+    //own record. writers unlink a node and retire() it, the node is handed to
+    //its deleter once the global epoch moved two steps past its retirement,
+    //at that point no thread can still be inside a critical section that saw it.
+    //there is a single domain, global(), so each thread needs one participant
+    class epoch_domain{
+    public:
+        //retired nodes a thread buffers before trying to advance the epoch.
+        //nodes a collect could not free count towards the next threshold, so
+        //a stalled reader makes retire() amortized O(1) instead of rescanning
+        static constexpr size_t k_collect_threshold = 64;
+
+        static epoch_domain& global()
+        {
+            static epoch_domain domain;
+            return domain;
+        }
+
+        epoch_domain(const epoch_domain&) = delete;
+        epoch_domain& operator=(const epoch_domain&) = delete;
+
+        ~epoch_domain();
+
+        //critical sections nest, only the outermost one pins
+        void enter();
+        void exit();
+
+        template<typename T, typename Deleter = default_delete<T>>
+        void retire(T* p)
+        {
+            retire(p, &reclaim<T, Deleter>);
+        }
+
+        //frees whatever the current epoch allows, returns whether the epoch advanced
+        bool collect();
+
+        inline uint64_t epoch() const noexcept{return global_epoch_.load(std::memory_order_relaxed);}
+
+    private:
+        struct retired_node{
+            void* ptr;
+            void (*reclaim)(void*);
+            uint64_t epoch;
+        };
+
+        //one per thread, cache line aligned so pinning does not false share.
+        //records are never freed, a thread exiting leaves its record for reuse
+        struct alignas(64) record{
+            //(epoch << 1) | active
+            std::atomic<uint64_t> state{0};
+            std::atomic<bool> in_use{true};
+            record* next = nullptr;
+        };
+
+        //thread local side of a record
+        struct participant{
+            epoch_domain* domain = nullptr;
+            record* rec = nullptr;
+            size_t nesting = 0;
+            std::vector<retired_node> retired;
+            //retired.size() that triggers the next collect
+            size_t collect_at = k_collect_threshold;
+
+            ~participant();
+        };
+
+        epoch_domain() = default;
+
+        template<typename T, typename Deleter>
+        static void reclaim(void* p)
+        {
+            Deleter deleter;
+            deleter(static_cast<T*>(p));
+        }
+
+        void retire(void* p, void (*reclaim)(void*));
+
+        participant& local();
+
+        record* acquire_record();
+
+        //advances the global epoch if every pinned thread has seen it
+        bool try_advance();
+
+        //frees the nodes retired two or more epochs ago, keeps the rest in order
+        static void reclaim_expired(std::vector<retired_node>& nodes, uint64_t epoch);
+
+        std::atomic<uint64_t> global_epoch_{2};
+        std::atomic<record*> records_{nullptr};
+
+        //retired nodes left behind by exited threads
+        std::mutex orphans_mutex_;
+        std::vector<retired_node> orphans_;
+    };
+
+    //pins the calling thread in the global domain for its lifetime, every
+    //node read while it is alive stays valid until it is destroyed
+    class epoch_guard{
+    public:
+        epoch_guard(){epoch_domain::global().enter();}
+
+        epoch_guard(const epoch_guard&) = delete;
+        epoch_guard& operator=(const epoch_guard&) = delete;
+
+        ~epoch_guard(){epoch_domain::global().exit();}
+    };
+
+    inline epoch_domain::~epoch_domain()
+    {
+        //every thread is gone at static destruction
+        reclaim_expired(orphans_, UINT64_MAX);
+        record* rec = records_.load();
+        while(rec != nullptr)
+        {
+            record* next = rec->next;
+            delete rec;
+            rec = next;
+        }
+    }
+
+    inline epoch_domain::participant::~participant()
+    {
+        if(rec == nullptr)
+        {
+            return;
+        }
+        domain->try_advance();
+        reclaim_expired(retired, domain->global_epoch_.load(std::memory_order_acquire));
+        if(!retired.empty())
+        {
+            std::lock_guard<std::mutex> lock(domain->orphans_mutex_);
+            domain->orphans_.insert(domain->orphans_.end(), retired.begin(), retired.end());
+        }
+        rec->state.store(0, std::memory_order_release);
+        rec->in_use.store(false, std::memory_order_release);
+    }
+
+    inline epoch_domain::participant& epoch_domain::local()
+    {
+        thread_local participant self;
+        if(self.rec == nullptr)
+        {
+            self.domain = this;
+            self.rec = acquire_record();
+        }
+        return self;
+    }
+
+    inline epoch_domain::record* epoch_domain::acquire_record()
+    {
+        for(record* rec = records_.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+        {
+            bool expected = false;
+            if(!rec->in_use.load(std::memory_order_relaxed)
+                && rec->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return rec;
+            }
+        }
+        record* rec = new record();
+        rec->next = records_.load(std::memory_order_relaxed);
+        while(!records_.compare_exchange_weak(rec->next, rec, std::memory_order_release, std::memory_order_relaxed));
+        return rec;
+    }
+
+    inline void epoch_domain::enter()
+    {
+        participant& self = local();
+        if(self.nesting++ != 0)
+        {
+            return;
+        }
+        uint64_t epoch = global_epoch_.load(std::memory_order_relaxed);
+        self.rec->state.store((epoch << 1) | 1, std::memory_order_relaxed);
+        //the pin must be visible before any shared pointer is read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    inline void epoch_domain::exit()
+    {
+        participant& self = local();
+        if(--self.nesting != 0)
+        {
+            return;
+        }
+        uint64_t state = self.rec->state.load(std::memory_order_relaxed);
+        self.rec->state.store(state & ~uint64_t(1), std::memory_order_release);
+    }
+
+    inline void epoch_domain::retire(void* p, void (*reclaim)(void*))
+    {
+        participant& self = local();
+        //the stamp has to be ordered after the unlink that preceded this call
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        self.retired.push_back(retired_node{p, reclaim, global_epoch_.load(std::memory_order_relaxed)});
+        if(self.retired.size() >= self.collect_at)
+        {
+            collect();
+        }
+    }
+
+    inline bool epoch_domain::try_advance()
+    {
+        uint64_t epoch = global_epoch_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for(record* rec = records_.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+        {
+            //acquire pairs with the release in exit(), whatever the thread
+            //read in its last critical section happens before the advance
+            uint64_t state = rec->state.load(std::memory_order_acquire);
+            if((state & 1) && (state >> 1) != epoch)
+            {
+                return false;
+            }
+        }
+        return global_epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+    }
+
+    inline bool epoch_domain::collect()
+    {
+        bool advanced = try_advance();
+        uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+        participant& self = local();
+        reclaim_expired(self.retired, epoch);
+        //whatever is left waits for at least as many new retirements
+        size_t left = self.retired.size();
+        self.collect_at = left + (left > k_collect_threshold ? left : k_collect_threshold);
+        std::unique_lock<std::mutex> lock(orphans_mutex_, std::try_to_lock);
+        if(lock.owns_lock() && !orphans_.empty())
+        {
+            reclaim_expired(orphans_, epoch);
+        }
+        return advanced;
+    }
+
+    inline void epoch_domain::reclaim_expired(std::vector<retired_node>& nodes, uint64_t epoch)
+    {
+        size_t kept = 0;
+        for(size_t i = 0; i < nodes.size(); i++)
+        {
+            if(nodes[i].epoch + 2 <= epoch)
+            {
+                nodes[i].reclaim(nodes[i].ptr);
+            }
+            else
+            {
+                nodes[kept++] = nodes[i];
+            }
+        }
+        nodes.resize(kept);
+    }
+}
+
+#endif //TINYSTL_EPOCH_H
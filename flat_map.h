@@ -0,0 +1,285 @@
+#ifndef TINYSTL_FLAT_MAP_H
+#define TINYSTL_FLAT_MAP_H
+
+#include <stdexcept>
+
+#include "flat_set.h"
+
+namespace tinystl{
+    //walks the key and value arrays of a FlatMap in lockstep
+    template<typename Key, typename Value, typename ValuePointer>
+    class flat_map_iterator{
+    public:
+        using mapped_reference = decltype(*ValuePointer());
+        using reference = std::pair<const Key&, mapped_reference>;
+
+        //operator-> has to return something holding the proxy pair
+        struct arrow_proxy{
+            reference ref;
+            reference* operator->(){return &ref;}
+        };
+
+        using iterator_category = random_access_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = ptrdiff_t;
+        using pointer = arrow_proxy;
+
+        flat_map_iterator():key_(nullptr), value_(nullptr){}
+        flat_map_iterator(const Key* key, ValuePointer value):key_(key), value_(value){}
+
+        //iterator -> const_iterator
+        template<typename P, typename = typename std::enable_if<std::is_convertible<P, ValuePointer>::value>::type>
+        flat_map_iterator(const flat_map_iterator<Key, Value, P>& other):
+        key_(other.key_ptr()), value_(other.value_ptr()){}
+
+        inline const Key* key_ptr() const{return key_;}
+        inline ValuePointer value_ptr() const{return value_;}
+
+        inline const Key& key() const{return *key_;}
+        inline mapped_reference value() const{return *value_;}
+
+        reference operator*() const{return reference(*key_, *value_);}
+        pointer operator->() const{return pointer{**this};}
+        reference operator[](difference_type n) const{return reference(key_[n], value_[n]);}
+
+        flat_map_iterator& operator++(){++key_; ++value_; return *this;}
+        flat_map_iterator operator++(int){flat_map_iterator tmp = *this; ++*this; return tmp;}
+        flat_map_iterator& operator--(){--key_; --value_; return *this;}
+        flat_map_iterator operator--(int){flat_map_iterator tmp = *this; --*this; return tmp;}
+        flat_map_iterator& operator+=(difference_type n){key_ += n; value_ += n; return *this;}
+        flat_map_iterator& operator-=(difference_type n){key_ -= n; value_ -= n; return *this;}
+        flat_map_iterator operator+(difference_type n) const{return flat_map_iterator(key_ + n, value_ + n);}
+        flat_map_iterator operator-(difference_type n) const{return flat_map_iterator(key_ - n, value_ - n);}
+        difference_type operator-(const flat_map_iterator& other) const{return key_ - other.key_;}
+
+        bool operator==(const flat_map_iterator& other) const{return key_ == other.key_;}
+        bool operator!=(const flat_map_iterator& other) const{return key_ != other.key_;}
+        bool operator<(const flat_map_iterator& other) const{return key_ < other.key_;}
+        bool operator>(const flat_map_iterator& other) const{return key_ > other.key_;}
+        bool operator<=(const flat_map_iterator& other) const{return key_ <= other.key_;}
+        bool operator>=(const flat_map_iterator& other) const{return key_ >= other.key_;}
+
+    private:
+        const Key* key_;
+        ValuePointer value_;
+    };
+
+    //sorted map keeping keys and values in two parallel arrays, so lookups
+    //only touch the key array
+    template<typename Key, typename Value, typename Compare = std::less<Key>>
+    class FlatMap{
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using key_compare = Compare;
+        using iterator = flat_map_iterator<Key, Value, Value*>;
+        using const_iterator = flat_map_iterator<Key, Value, const Value*>;
+
+        FlatMap():comp_(){}
+
+        explicit FlatMap(const Compare& comp):comp_(comp){}
+
+        //bulk construction from unsorted (key, value) pairs, the first
+        //occurrence of a duplicated key wins
+        template<typename InputIterator>
+        FlatMap(InputIterator first, InputIterator last, const Compare& comp = Compare());
+
+        FlatMap(std::initializer_list<value_type> ilist, const Compare& comp = Compare());
+
+        template<typename InputIterator>
+        void assign(InputIterator first, InputIterator last);
+
+        inline size_type size() const noexcept{return keys_.size();}
+        inline bool empty() const noexcept{return keys_.size() == 0;}
+        inline key_compare key_comp() const{return comp_;}
+
+        inline const Key* keys() const noexcept{return keys_.data();}
+        inline Value* values() noexcept{return values_.data();}
+        inline const Value* values() const noexcept{return values_.data();}
+
+        iterator begin() noexcept{return iterator(keys_.data(), values_.data());}
+        iterator end() noexcept{return begin() + size();}
+        const_iterator begin() const noexcept{return const_iterator(keys_.data(), values_.data());}
+        const_iterator end() const noexcept{return begin() + size();}
+
+        iterator lower_bound(const Key& key){return begin() + lower_index(key);}
+        const_iterator lower_bound(const Key& key) const{return begin() + lower_index(key);}
+
+        iterator upper_bound(const Key& key)
+        {
+            return begin() + (branchless_upper_bound(keys_.data(), size(), key, comp_) - keys_.data());
+        }
+        const_iterator upper_bound(const Key& key) const
+        {
+            return begin() + (branchless_upper_bound(keys_.data(), size(), key, comp_) - keys_.data());
+        }
+
+        iterator find(const Key& key){return begin() + find_index(key);}
+        const_iterator find(const Key& key) const{return begin() + find_index(key);}
+
+        inline bool contains(const Key& key) const{return find_index(key) != size();}
+        inline size_type count(const Key& key) const{return contains(key) ? 1 : 0;}
+
+        Value& at(const Key& key);
+        const Value& at(const Key& key) const;
+
+        //inserts a value initialized mapped value when key is missing
+        Value& operator[](const Key& key);
+
+        //O(n) insert, prefer bulk construction for large inputs
+        std::pair<iterator, bool> insert(const Key& key, const Value& value);
+
+        size_type erase(const Key& key);
+
+        void reserve(size_type n){keys_.reserve(n); values_.reserve(n);}
+
+        void clear(){keys_.clear(); values_.clear();}
+
+    private:
+        inline size_type lower_index(const Key& key) const
+        {
+            return branchless_lower_bound(keys_.data(), size(), key, comp_) - keys_.data();
+        }
+
+        //size() when key is missing
+        size_type find_index(const Key& key) const;
+
+        //inserts key and value before pos in both arrays, or in neither
+        void insert_at(size_type pos, Key&& key, Value&& value);
+
+        flat_array<Key> keys_;
+        flat_array<Value> values_;
+        Compare comp_;
+    };
+
+    template<typename Key, typename Value, typename Compare>
+    template<typename InputIterator>
+    FlatMap<Key, Value, Compare>::FlatMap(InputIterator first, InputIterator last, const Compare& comp):
+    comp_(comp)
+    {
+        assign(first, last);
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    FlatMap<Key, Value, Compare>::FlatMap(std::initializer_list<value_type> ilist, const Compare& comp):
+    comp_(comp)
+    {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    template<typename InputIterator>
+    void FlatMap<Key, Value, Compare>::assign(InputIterator first, InputIterator last)
+    {
+        clear();
+        flat_array<value_type> entries;
+        for(; first != last; ++first)
+        {
+            entries.emplace_back(first->first, first->second);
+        }
+        value_type* data = entries.data();
+        Compare comp = comp_;
+        tinystl::stable_sort(data, data + entries.size(), [comp](const value_type& a, const value_type& b){
+            return comp(a.first, b.first);
+        });
+        //scatter into the key/value arrays while dropping duplicated keys
+        reserve(entries.size());
+        for(size_type i = 0; i < entries.size(); i++)
+        {
+            if(i == 0 || comp_(keys_[keys_.size() - 1], data[i].first))
+            {
+                keys_.emplace_back(std::move(data[i].first));
+                values_.emplace_back(std::move(data[i].second));
+            }
+        }
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    typename FlatMap<Key, Value, Compare>::size_type FlatMap<Key, Value, Compare>::find_index(const Key& key) const
+    {
+        size_type pos = lower_index(key);
+        return (pos != size() && !comp_(key, keys_[pos])) ? pos : size();
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    Value& FlatMap<Key, Value, Compare>::at(const Key& key)
+    {
+        size_type pos = find_index(key);
+        if(pos == size())
+        {
+            throw std::out_of_range("tinystl::FlatMap::at");
+        }
+        return values_[pos];
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    const Value& FlatMap<Key, Value, Compare>::at(const Key& key) const
+    {
+        size_type pos = find_index(key);
+        if(pos == size())
+        {
+            throw std::out_of_range("tinystl::FlatMap::at");
+        }
+        return values_[pos];
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    Value& FlatMap<Key, Value, Compare>::operator[](const Key& key)
+    {
+        size_type pos = lower_index(key);
+        if(pos == size() || comp_(key, keys_[pos]))
+        {
+            insert_at(pos, Key(key), Value());
+        }
+        return values_[pos];
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    std::pair<typename FlatMap<Key, Value, Compare>::iterator, bool>
+    FlatMap<Key, Value, Compare>::insert(const Key& key, const Value& value)
+    {
+        size_type pos = lower_index(key);
+        if(pos != size() && !comp_(key, keys_[pos]))
+        {
+            return {begin() + pos, false};
+        }
+        insert_at(pos, Key(key), Value(value));
+        return {begin() + pos, true};
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    void FlatMap<Key, Value, Compare>::insert_at(size_type pos, Key&& key, Value&& value)
+    {
+        //grow both arrays up front, after that only a throwing move can fail
+        keys_.reserve_one();
+        values_.reserve_one();
+        keys_.insert_at(pos, std::move(key));
+        try
+        {
+            values_.insert_at(pos, std::move(value));
+        }
+        catch(...)
+        {
+            keys_.erase_at(pos);
+            throw;
+        }
+    }
+
+    template<typename Key, typename Value, typename Compare>
+    typename FlatMap<Key, Value, Compare>::size_type FlatMap<Key, Value, Compare>::erase(const Key& key)
+    {
+        size_type pos = find_index(key);
+        if(pos == size())
+        {
+            return 0;
+        }
+        keys_.erase_at(pos);
+        values_.erase_at(pos);
+        return 1;
+    }
+}
+
+#endif //TINYSTL_FLAT_MAP_H
@@ -0,0 +1,346 @@
+#ifndef TINYSTL_FLAT_SET_H
+#define TINYSTL_FLAT_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+
+namespace tinystl{
+    //lower_bound over a sorted contiguous range without a data dependent branch,
+    //the loop trip count only depends on n so the compiler emits a cmov
+    template<typename T, typename Key, typename Compare>
+    const T* branchless_lower_bound(const T* first, size_t n, const Key& key, Compare comp)
+    {
+        if(n == 0)
+        {
+            return first;
+        }
+        while(n > 1)
+        {
+            size_t half = n / 2;
+            first = comp(first[half - 1], key) ? first + half : first;
+            n -= half;
+        }
+        return first + comp(*first, key);
+    }
+
+    template<typename T, typename Key, typename Compare>
+    const T* branchless_upper_bound(const T* first, size_t n, const Key& key, Compare comp)
+    {
+        if(n == 0)
+        {
+            return first;
+        }
+        while(n > 1)
+        {
+            size_t half = n / 2;
+            first = !comp(key, first[half - 1]) ? first + half : first;
+            n -= half;
+        }
+        return first + !comp(key, *first);
+    }
+
+    //contiguous buffer used as the backing store of FlatSet/FlatMap
+    template<typename T>
+    class flat_array{
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using size_type = size_t;
+        using allocator_type = Allocator<T>;
+
+        flat_array():data_(nullptr), size_(0), capacity_(0){}
+
+        flat_array(const flat_array& other);
+
+        flat_array(flat_array&& other) noexcept;
+
+        flat_array& operator=(flat_array other) noexcept;
+
+        ~flat_array();
+
+        inline size_type size() const noexcept{return size_;}
+        inline size_type capacity() const noexcept{return capacity_;}
+        inline pointer data() noexcept{return data_;}
+        inline const_pointer data() const noexcept{return data_;}
+
+        T& operator[](size_type i){return data_[i];}
+        const T& operator[](size_type i) const{return data_[i];}
+
+        void reserve(size_type n);
+
+        //makes room for one more element, growing geometrically
+        void reserve_one(){if(size_ == capacity_) reserve(capacity_ == 0 ? 8 : capacity_ * 2);}
+
+        template<typename... Args>
+        void emplace_back(Args&&... args);
+
+        //insert before pos, shifting the tail by one
+        void insert_at(size_type pos, T&& value);
+
+        void erase_at(size_type pos);
+
+        //destroy every element from n on
+        void truncate(size_type n);
+
+        void clear(){truncate(0);}
+
+        void swap(flat_array& other) noexcept;
+
+    private:
+        pointer data_;
+        size_type size_;
+        size_type capacity_;
+    };
+
+    template<typename T>
+    flat_array<T>::flat_array(const flat_array& other):
+    data_(allocator_type::allocate(other.size_)), size_(0), capacity_(other.size_)
+    {
+        for(; size_ < other.size_; ++size_)
+        {
+            allocator_type::construct(data_ + size_, other.data_[size_]);
+        }
+    }
+
+    template<typename T>
+    flat_array<T>::flat_array(flat_array&& other) noexcept:
+    data_(other.data_), size_(other.size_), capacity_(other.capacity_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    template<typename T>
+    flat_array<T>& flat_array<T>::operator=(flat_array other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    template<typename T>
+    flat_array<T>::~flat_array()
+    {
+        truncate(0);
+        allocator_type::deallocate(data_, capacity_);
+    }
+
+    template<typename T>
+    void flat_array<T>::reserve(size_type n)
+    {
+        if(n <= capacity_)
+        {
+            return;
+        }
+        pointer buffer = allocator_type::allocate(n);
+        for(size_type i = 0; i < size_; i++)
+        {
+            allocator_type::construct(buffer + i, std::move(data_[i]));
+            allocator_type::destroy(data_ + i);
+        }
+        allocator_type::deallocate(data_, capacity_);
+        data_ = buffer;
+        capacity_ = n;
+    }
+
+    template<typename T>
+    template<typename... Args>
+    void flat_array<T>::emplace_back(Args&&... args)
+    {
+        reserve_one();
+        allocator_type::construct(data_ + size_, std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    template<typename T>
+    void flat_array<T>::insert_at(size_type pos, T&& value)
+    {
+        if(pos == size_)
+        {
+            emplace_back(std::move(value));
+            return;
+        }
+        reserve_one();
+        allocator_type::construct(data_ + size_, std::move(data_[size_ - 1]));
+        for(size_type i = size_ - 1; i > pos; i--)
+        {
+            data_[i] = std::move(data_[i - 1]);
+        }
+        data_[pos] = std::move(value);
+        ++size_;
+    }
+
+    template<typename T>
+    void flat_array<T>::erase_at(size_type pos)
+    {
+        for(size_type i = pos + 1; i < size_; i++)
+        {
+            data_[i - 1] = std::move(data_[i]);
+        }
+        truncate(size_ - 1);
+    }
+
+    template<typename T>
+    void flat_array<T>::truncate(size_type n)
+    {
+        while(size_ > n)
+        {
+            allocator_type::destroy(data_ + --size_);
+        }
+    }
+
+    template<typename T>
+    void flat_array<T>::swap(flat_array& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    //sorted set on a contiguous array, built once and then read
+    template<typename Key, typename Compare = std::less<Key>>
+    class FlatSet{
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using key_compare = Compare;
+        using reference = const Key&;
+        using const_reference = const Key&;
+        //keys must stay sorted, so only const access is handed out
+        using iterator = const Key*;
+        using const_iterator = const Key*;
+
+        FlatSet():comp_(){}
+
+        explicit FlatSet(const Compare& comp):comp_(comp){}
+
+        //bulk construction from unsorted input, duplicated keys are dropped
+        template<typename InputIterator>
+        FlatSet(InputIterator first, InputIterator last, const Compare& comp = Compare());
+
+        FlatSet(std::initializer_list<Key> ilist, const Compare& comp = Compare());
+
+        template<typename InputIterator>
+        void assign(InputIterator first, InputIterator last);
+
+        inline size_type size() const noexcept{return keys_.size();}
+        inline bool empty() const noexcept{return keys_.size() == 0;}
+        inline const Key* data() const noexcept{return keys_.data();}
+        inline key_compare key_comp() const{return comp_;}
+
+        iterator begin() const noexcept{return keys_.data();}
+        iterator end() const noexcept{return keys_.data() + keys_.size();}
+
+        iterator lower_bound(const Key& key) const
+        {
+            return branchless_lower_bound(keys_.data(), keys_.size(), key, comp_);
+        }
+
+        iterator upper_bound(const Key& key) const
+        {
+            return branchless_upper_bound(keys_.data(), keys_.size(), key, comp_);
+        }
+
+        iterator find(const Key& key) const;
+
+        inline bool contains(const Key& key) const{return find(key) != end();}
+        inline size_type count(const Key& key) const{return contains(key) ? 1 : 0;}
+
+        //O(n) insert, prefer bulk construction for large inputs
+        std::pair<iterator, bool> insert(const Key& key);
+
+        size_type erase(const Key& key);
+
+        void reserve(size_type n){keys_.reserve(n);}
+
+        void clear(){keys_.clear();}
+
+    private:
+        flat_array<Key> keys_;
+        Compare comp_;
+    };
+
+    template<typename Key, typename Compare>
+    template<typename InputIterator>
+    FlatSet<Key, Compare>::FlatSet(InputIterator first, InputIterator last, const Compare& comp):
+    comp_(comp)
+    {
+        assign(first, last);
+    }
+
+    template<typename Key, typename Compare>
+    FlatSet<Key, Compare>::FlatSet(std::initializer_list<Key> ilist, const Compare& comp):
+    comp_(comp)
+    {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    template<typename Key, typename Compare>
+    template<typename InputIterator>
+    void FlatSet<Key, Compare>::assign(InputIterator first, InputIterator last)
+    {
+        keys_.clear();
+        for(; first != last; ++first)
+        {
+            keys_.emplace_back(*first);
+        }
+        Key* data = keys_.data();
+        tinystl::sort(data, data + keys_.size(), comp_);
+        //single compaction pass, keep the first key of every equal run
+        size_type out = 0;
+        for(size_type i = 0; i < keys_.size(); i++)
+        {
+            if(out == 0 || comp_(data[out - 1], data[i]))
+            {
+                if(out != i)
+                {
+                    data[out] = std::move(data[i]);
+                }
+                ++out;
+            }
+        }
+        keys_.truncate(out);
+    }
+
+    template<typename Key, typename Compare>
+    typename FlatSet<Key, Compare>::iterator FlatSet<Key, Compare>::find(const Key& key) const
+    {
+        iterator it = lower_bound(key);
+        return (it != end() && !comp_(key, *it)) ? it : end();
+    }
+
+    template<typename Key, typename Compare>
+    std::pair<typename FlatSet<Key, Compare>::iterator, bool> FlatSet<Key, Compare>::insert(const Key& key)
+    {
+        size_type pos = lower_bound(key) - begin();
+        if(pos != size() && !comp_(key, keys_[pos]))
+        {
+            return {begin() + pos, false};
+        }
+        keys_.insert_at(pos, Key(key));
+        return {begin() + pos, true};
+    }
+
+    template<typename Key, typename Compare>
+    typename FlatSet<Key, Compare>::size_type FlatSet<Key, Compare>::erase(const Key& key)
+    {
+        iterator it = find(key);
+        if(it == end())
+        {
+            return 0;
+        }
+        keys_.erase_at(it - begin());
+        return 1;
+    }
+}
+
+#endif //TINYSTL_FLAT_SET_H
@@ -2,6 +2,9 @@
 #define TINYSTL_FUNCTIONAL_H
 
 #include <memory>
+#include <type_traits>
+
+#include "compressed_pair.h"
 namespace tinystl{
     template<typename T>
     class function;
@@ -14,32 +17,43 @@ namespace tinystl{
         {
         }
 
+        //any other callable with a matching signature, e.g. a lambda
+        template<typename Callable, typename = typename std::enable_if<
+            !std::is_same<typename std::decay<Callable>::type, function>::value &&
+            std::is_invocable_r<ReturnType, typename std::decay<Callable>::type&, VARS...>::value>::type>
+        function(Callable&& func):
+        callable(std::make_unique<callable_impl<typename std::decay<Callable>::type>>(std::forward<Callable>(func)))
+        {
+        }
+
         ReturnType operator()(VARS ... vars)
         {
             return callable->call(vars...);
         }
 
-    private:
-
+        //type erased storage, public so its layout can be checked
         struct callable_interface{
             virtual ReturnType call(VARS...) = 0;
             virtual ~callable_interface() = default;
         };
 
+        //a stateless callable is an empty base, the impl is just the vtable pointer
         template<typename Callable>
-        struct callable_impl: public callable_interface{
+        struct callable_impl: public callable_interface, private compressed_pair_elem<Callable, 0>{
+            using callable_base = compressed_pair_elem<Callable, 0>;
             callable_impl( Callable callable):
-            callable_(std::move(callable))
+            callable_base(std::move(callable))
             {
             
             }
             ReturnType call(VARS... vars)
             {
-                return callable_(vars...);
+                return callable_base::get()(vars...);
             }
-            Callable callable_;
         };
 
+    private:
+
         std::unique_ptr<callable_interface> callable;
     }; 
 
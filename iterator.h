@@ -2,6 +2,7 @@
 #define TINYSTL_ITERATOR_H
 
 #include <cstddef>
+#include <iterator>
 
 #include "type_trait.h"
 
@@ -33,8 +34,32 @@ namespace tinystl
         static const bool value = (sizeof(test<T>(0)) == sizeof(char));
     };
 
+    //standard library iterators carry std tags, map them onto ours
+    template<typename Category>
+    struct std_iterator_category{};
+
+    template<> struct std_iterator_category<std::input_iterator_tag>{using type = input_iterator_tag;};
+    template<> struct std_iterator_category<std::output_iterator_tag>{using type = output_iterator_tag;};
+    template<> struct std_iterator_category<std::forward_iterator_tag>{using type = forward_iterator_tag;};
+    template<> struct std_iterator_category<std::bidirectional_iterator_tag>{using type = bidirectional_iterator_tag;};
+    template<> struct std_iterator_category<std::random_access_iterator_tag>{using type = random_access_iterator_tag;};
+    template<> struct std_iterator_category<std::contiguous_iterator_tag>{using type = random_access_iterator_tag;};
+
+    template<typename Iterator, typename = void>
+    struct std_iterator_trait_impl{};
+
+    template<typename Iterator>
+    struct std_iterator_trait_impl<Iterator, std::void_t<typename std_iterator_category<typename Iterator::iterator_category>::type>>
+    {
+        using iterator_category = typename std_iterator_category<typename Iterator::iterator_category>::type;
+        using value_type = typename std::iterator_traits<Iterator>::value_type;
+        using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+        using pointer = typename std::iterator_traits<Iterator>::pointer;
+        using reference = typename std::iterator_traits<Iterator>::reference;
+    };
+
     template<typename Iterator, bool value>
-    struct iterator_trait_impl{};
+    struct iterator_trait_impl: public std_iterator_trait_impl<Iterator>{};
 
     template<typename Iterator>
     struct iterator_trait_impl<Iterator, true>
@@ -56,7 +81,7 @@ namespace tinystl
 
     template<typename Iterator>
     struct iterator_trait_helper<Iterator, true>
-    : public iterator_trait_impl<Iterator, k_is_iterator >{};
+    : public iterator_trait_impl<Iterator, k_is_iterator<Iterator> >{};
 
     template<typename Iterator>
     struct iterator_trait: public iterator_trait_helper<Iterator, has_iterator_category<Iterator>::value>{};
@@ -99,9 +124,9 @@ namespace tinystl
     }
 
     //check whether T is a iterator, what the iterator category(U) is
-    template<typename T, typename U, bool value = has_iterator_category<T>::value>
+    template<typename T, typename U, bool value = has_iterator_category<iterator_trait<T>>::value>
     struct has_iterator_category_of
-    : public m_bool_constant<std::is_convertible<typename T::iterator_category,U>>{};
+    : public m_bool_constant<std::is_convertible<typename iterator_trait<T>::iterator_category,U>::value>{};
 
     template<typename T, typename U>
     struct has_iterator_category_of<T, U, false>: public m_false_type{};
@@ -118,7 +143,7 @@ namespace tinystl
     //random_access
     template<typename Iterator> struct is_random_access_iterator: public has_iterator_category_of<Iterator, random_access_iterator_tag>{};
 
-    template<typename Iterator> struct is_iterator: public m_bool_constant<b_is_iterator>{};
+    template<typename Iterator> struct is_iterator: public m_bool_constant<is_input_iterator<Iterator>::value || is_output_iterator<Iterator>::value>{};
 
     //input advance
     template<typename Iterator, typename Distance>
@@ -131,7 +156,7 @@ namespace tinystl
     template<typename Iterator, typename Distance>
     void advance_dispatch(Iterator& it, Distance n, forward_iterator_tag)
     {
-        advance_dispatch(it, n, input_iterator_tag())
+        advance_dispatch(it, n, input_iterator_tag());
     }
 
     //bidirectional advance
@@ -144,7 +169,7 @@ namespace tinystl
         }
         else
         {
-            while(n++) --t;
+            while(n++) --it;
         }
     }
 
@@ -167,7 +192,7 @@ namespace tinystl
         typename iterator_trait<Iterator>::difference_type dist{};
         while(begin != end)
         {
-            end--;
+            ++begin;
             dist++;
         }
         return dist;    
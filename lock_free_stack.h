@@ -0,0 +1,105 @@
+#ifndef TINYSTL_LOCK_FREE_STACK_H
+#define TINYSTL_LOCK_FREE_STACK_H
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "epoch.h"
+
+namespace tinystl{
+    //Treiber stack, popped nodes are retired through epoch_domain so a
+    //concurrent pop still reading head->next never touches freed memory,
+    //which also rules out ABA on head.
+    //T must be copyable: pop copies the value out because a concurrent
+    //for_each may still be reading the node, so move-only types are rejected
+    template<typename T>
+    class lock_free_stack{
+        static_assert(std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value,
+            "lock_free_stack<T> requires a copyable T, pop() copies so that concurrent for_each stays safe");
+
+    public:
+        lock_free_stack():head_(nullptr){}
+
+        lock_free_stack(const lock_free_stack&) = delete;
+        lock_free_stack& operator=(const lock_free_stack&) = delete;
+
+        //no other thread may use the stack anymore
+        ~lock_free_stack();
+
+        void push(const T& value){push_node(new node(value));}
+        void push(T&& value){push_node(new node(std::move(value)));}
+
+        //false when the stack was empty. the value is copied out, not moved,
+        //since a concurrent for_each may still be reading the popped node
+        bool pop(T& value);
+
+        bool empty() const{return head_.load(std::memory_order_acquire) == nullptr;}
+
+        //calls f on every element from the top down, concurrent pushes and
+        //pops are fine. f gets a const reference and must not modify it
+        template<typename Func>
+        void for_each(Func f) const;
+
+    private:
+        struct node{
+            template<typename U>
+            explicit node(U&& v):value(std::forward<U>(v)), next(nullptr){}
+
+            T value;
+            node* next;
+        };
+
+        void push_node(node* n);
+
+        std::atomic<node*> head_;
+    };
+
+    template<typename T>
+    lock_free_stack<T>::~lock_free_stack()
+    {
+        node* n = head_.load(std::memory_order_relaxed);
+        while(n != nullptr)
+        {
+            node* next = n->next;
+            default_delete<node>()(n);
+            n = next;
+        }
+    }
+
+    template<typename T>
+    void lock_free_stack<T>::push_node(node* n)
+    {
+        n->next = head_.load(std::memory_order_relaxed);
+        while(!head_.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    template<typename T>
+    bool lock_free_stack<T>::pop(T& value)
+    {
+        epoch_guard guard;
+        node* n = head_.load(std::memory_order_acquire);
+        while(n != nullptr && !head_.compare_exchange_weak(n, n->next, std::memory_order_acquire, std::memory_order_acquire));
+        if(n == nullptr)
+        {
+            return false;
+        }
+        //the node stays untouched until it is reclaimed
+        value = n->value;
+        epoch_domain::global().retire(n);
+        return true;
+    }
+
+    template<typename T>
+    template<typename Func>
+    void lock_free_stack<T>::for_each(Func f) const
+    {
+        epoch_guard guard;
+        for(const node* n = head_.load(std::memory_order_acquire); n != nullptr; n = n->next)
+        {
+            f(n->value);
+        }
+    }
+}
+
+#endif //TINYSTL_LOCK_FREE_STACK_H
@@ -0,0 +1,571 @@
+#ifndef TINYSTL_RANGES_H
+#define TINYSTL_RANGES_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "iterator.h"
+
+namespace tinystl{
+    template<typename Range>
+    using range_iterator_t = decltype(std::begin(std::declval<Range&>()));
+
+    template<typename Iterator>
+    using iterator_category_t = typename iterator_trait<Iterator>::iterator_category;
+
+    //Category if it is no stronger than Limit, Limit otherwise
+    template<typename Category, typename Limit>
+    using weaker_category_t = typename std::conditional<std::is_convertible<Category, Limit>::value, Limit, Category>::type;
+
+    //non owning view of an lvalue range
+    template<typename Range>
+    class ref_view{
+    public:
+        explicit ref_view(Range& range):range_(&range){}
+
+        range_iterator_t<Range> begin() const{return std::begin(*range_);}
+        range_iterator_t<Range> end() const{return std::end(*range_);}
+
+    private:
+        Range* range_;
+    };
+
+    //lvalue ranges are referenced, rvalue ranges (usually other views) are moved in
+    template<typename Range>
+    using all_t = typename std::conditional<std::is_lvalue_reference<Range>::value,
+        ref_view<typename std::remove_reference<Range>::type>, typename std::decay<Range>::type>::type;
+
+    template<typename Range>
+    all_t<Range> all(Range&& range)
+    {
+        return all_t<Range>(std::forward<Range>(range));
+    }
+
+    template<typename Iterator>
+    class subrange{
+    public:
+        using iterator = Iterator;
+
+        subrange(Iterator first, Iterator last):first_(first), last_(last){}
+
+        Iterator begin() const{return first_;}
+        Iterator end() const{return last_;}
+        bool empty() const{return first_ == last_;}
+        typename iterator_trait<Iterator>::difference_type size() const{return tinystl::distance(first_, last_);}
+
+    private:
+        Iterator first_;
+        Iterator last_;
+    };
+
+    //iterators of every view below point back into the view they came from,
+    //so the view has to outlive them and must not be moved while iterating
+
+    //---------------------------------------------------------------
+    //transform
+
+    template<typename View, typename Func>
+    class transform_view{
+    public:
+        using base_iterator = range_iterator_t<View>;
+
+        class iterator{
+        public:
+            using iterator_category = iterator_category_t<base_iterator>;
+            using reference = decltype(std::declval<Func&>()(*std::declval<base_iterator&>()));
+            using value_type = typename std::remove_cv<typename std::remove_reference<reference>::type>::type;
+            using difference_type = typename iterator_trait<base_iterator>::difference_type;
+            using pointer = void;
+
+            iterator():it_(), func_(nullptr){}
+            iterator(base_iterator it, Func* func):it_(it), func_(func){}
+
+            inline base_iterator base() const{return it_;}
+
+            reference operator*() const{return (*func_)(*it_);}
+            reference operator[](difference_type n) const{return (*func_)(it_[n]);}
+
+            iterator& operator++(){++it_; return *this;}
+            iterator operator++(int){iterator tmp = *this; ++it_; return tmp;}
+            iterator& operator--(){--it_; return *this;}
+            iterator operator--(int){iterator tmp = *this; --it_; return tmp;}
+            iterator& operator+=(difference_type n){it_ += n; return *this;}
+            iterator& operator-=(difference_type n){it_ -= n; return *this;}
+            iterator operator+(difference_type n) const{return iterator(it_ + n, func_);}
+            iterator operator-(difference_type n) const{return iterator(it_ - n, func_);}
+            difference_type operator-(const iterator& other) const{return it_ - other.it_;}
+
+            bool operator==(const iterator& other) const{return it_ == other.it_;}
+            bool operator!=(const iterator& other) const{return it_ != other.it_;}
+            bool operator<(const iterator& other) const{return it_ < other.it_;}
+
+        private:
+            base_iterator it_;
+            Func* func_;
+        };
+
+        transform_view(View base, Func func):base_(std::move(base)), func_(std::move(func)){}
+
+        iterator begin(){return iterator(std::begin(base_), &func_);}
+        iterator end(){return iterator(std::end(base_), &func_);}
+
+    private:
+        View base_;
+        Func func_;
+    };
+
+    //---------------------------------------------------------------
+    //filter
+
+    template<typename View, typename Pred>
+    class filter_view{
+    public:
+        using base_iterator = range_iterator_t<View>;
+
+        class iterator{
+        public:
+            using iterator_category = weaker_category_t<iterator_category_t<base_iterator>, bidirectional_iterator_tag>;
+            using value_type = typename iterator_trait<base_iterator>::value_type;
+            using difference_type = typename iterator_trait<base_iterator>::difference_type;
+            using pointer = typename iterator_trait<base_iterator>::pointer;
+            using reference = typename iterator_trait<base_iterator>::reference;
+
+            iterator():it_(), end_(), pred_(nullptr){}
+            iterator(base_iterator it, base_iterator end, Pred* pred):it_(it), end_(end), pred_(pred){}
+
+            inline base_iterator base() const{return it_;}
+
+            reference operator*() const{return *it_;}
+
+            iterator& operator++()
+            {
+                do
+                {
+                    ++it_;
+                }while(it_ != end_ && !(*pred_)(*it_));
+                return *this;
+            }
+            iterator operator++(int){iterator tmp = *this; ++*this; return tmp;}
+
+            //a matching element before the current one is guaranteed
+            iterator& operator--()
+            {
+                do
+                {
+                    --it_;
+                }while(!(*pred_)(*it_));
+                return *this;
+            }
+            iterator operator--(int){iterator tmp = *this; --*this; return tmp;}
+
+            bool operator==(const iterator& other) const{return it_ == other.it_;}
+            bool operator!=(const iterator& other) const{return it_ != other.it_;}
+
+        private:
+            base_iterator it_;
+            base_iterator end_;
+            Pred* pred_;
+        };
+
+        filter_view(View base, Pred pred):base_(std::move(base)), pred_(std::move(pred)){}
+
+        //O(n) in the number of leading rejected elements
+        iterator begin()
+        {
+            base_iterator it = std::begin(base_);
+            base_iterator last = std::end(base_);
+            while(it != last && !pred_(*it))
+            {
+                ++it;
+            }
+            return iterator(it, last, &pred_);
+        }
+
+        iterator end(){return iterator(std::end(base_), std::end(base_), &pred_);}
+
+    private:
+        View base_;
+        Pred pred_;
+    };
+
+    //---------------------------------------------------------------
+    //take
+
+    template<typename View>
+    class take_view{
+    public:
+        using base_iterator = range_iterator_t<View>;
+        using difference_type = typename iterator_trait<base_iterator>::difference_type;
+
+        //knows both its base position and how many elements it has passed,
+        //it reaches the end when either runs out
+        class iterator{
+        public:
+            using iterator_category = typename std::conditional<is_random_access_iterator<base_iterator>::value,
+                random_access_iterator_tag, weaker_category_t<iterator_category_t<base_iterator>, forward_iterator_tag>>::type;
+            using value_type = typename iterator_trait<base_iterator>::value_type;
+            using difference_type = typename iterator_trait<base_iterator>::difference_type;
+            using pointer = typename iterator_trait<base_iterator>::pointer;
+            using reference = typename iterator_trait<base_iterator>::reference;
+
+            iterator():it_(), pos_(0){}
+            iterator(base_iterator it, difference_type pos):it_(it), pos_(pos){}
+
+            inline base_iterator base() const{return it_;}
+
+            reference operator*() const{return *it_;}
+            reference operator[](difference_type n) const{return it_[n];}
+
+            iterator& operator++(){++it_; ++pos_; return *this;}
+            iterator operator++(int){iterator tmp = *this; ++*this; return tmp;}
+            iterator& operator--(){--it_; --pos_; return *this;}
+            iterator operator--(int){iterator tmp = *this; --*this; return tmp;}
+            iterator& operator+=(difference_type n){it_ += n; pos_ += n; return *this;}
+            iterator& operator-=(difference_type n){it_ -= n; pos_ -= n; return *this;}
+            iterator operator+(difference_type n) const{return iterator(it_ + n, pos_ + n);}
+            iterator operator-(difference_type n) const{return iterator(it_ - n, pos_ - n);}
+            difference_type operator-(const iterator& other) const{return pos_ - other.pos_;}
+
+            bool operator==(const iterator& other) const{return pos_ == other.pos_ || it_ == other.it_;}
+            bool operator!=(const iterator& other) const{return !(*this == other);}
+            bool operator<(const iterator& other) const{return pos_ < other.pos_;}
+
+        private:
+            base_iterator it_;
+            difference_type pos_;
+        };
+
+        take_view(View base, difference_type count):base_(std::move(base)), count_(count){}
+
+        iterator begin(){return iterator(std::begin(base_), 0);}
+
+        iterator end()
+        {
+            if constexpr(is_random_access_iterator<base_iterator>::value)
+            {
+                difference_type size = std::end(base_) - std::begin(base_);
+                difference_type n = count_ < size ? count_ : size;
+                return iterator(std::begin(base_) + n, n);
+            }
+            else
+            {
+                return iterator(std::end(base_), count_);
+            }
+        }
+
+    private:
+        View base_;
+        difference_type count_;
+    };
+
+    //---------------------------------------------------------------
+    //drop
+
+    template<typename View>
+    class drop_view{
+    public:
+        using iterator = range_iterator_t<View>;
+        using difference_type = typename iterator_trait<iterator>::difference_type;
+
+        drop_view(View base, difference_type count):base_(std::move(base)), count_(count){}
+
+        iterator begin()
+        {
+            iterator it = std::begin(base_);
+            iterator last = std::end(base_);
+            if constexpr(is_random_access_iterator<iterator>::value)
+            {
+                return it + (count_ < last - it ? count_ : last - it);
+            }
+            else
+            {
+                for(difference_type n = count_; n > 0 && it != last; n--)
+                {
+                    ++it;
+                }
+                return it;
+            }
+        }
+
+        iterator end(){return std::end(base_);}
+
+    private:
+        View base_;
+        difference_type count_;
+    };
+
+    //---------------------------------------------------------------
+    //zip
+
+    template<typename View1, typename View2>
+    class zip_view{
+    public:
+        using base_iterator1 = range_iterator_t<View1>;
+        using base_iterator2 = range_iterator_t<View2>;
+        static constexpr bool k_random_access =
+            is_random_access_iterator<base_iterator1>::value && is_random_access_iterator<base_iterator2>::value;
+
+        //stops at the end of the shorter range
+        class iterator{
+        public:
+            using iterator_category = typename std::conditional<k_random_access, random_access_iterator_tag,
+                weaker_category_t<weaker_category_t<iterator_category_t<base_iterator1>, iterator_category_t<base_iterator2>>,
+                forward_iterator_tag>>::type;
+            using reference = std::pair<typename iterator_trait<base_iterator1>::reference,
+                typename iterator_trait<base_iterator2>::reference>;
+            using value_type = std::pair<typename iterator_trait<base_iterator1>::value_type,
+                typename iterator_trait<base_iterator2>::value_type>;
+            using difference_type = typename iterator_trait<base_iterator1>::difference_type;
+            using pointer = void;
+
+            iterator():it1_(), it2_(){}
+            iterator(base_iterator1 it1, base_iterator2 it2):it1_(it1), it2_(it2){}
+
+            reference operator*() const{return reference(*it1_, *it2_);}
+            reference operator[](difference_type n) const{return reference(it1_[n], it2_[n]);}
+
+            iterator& operator++(){++it1_; ++it2_; return *this;}
+            iterator operator++(int){iterator tmp = *this; ++*this; return tmp;}
+            iterator& operator--(){--it1_; --it2_; return *this;}
+            iterator operator--(int){iterator tmp = *this; --*this; return tmp;}
+            iterator& operator+=(difference_type n){it1_ += n; it2_ += n; return *this;}
+            iterator& operator-=(difference_type n){it1_ -= n; it2_ -= n; return *this;}
+            iterator operator+(difference_type n) const{return iterator(it1_ + n, it2_ + n);}
+            iterator operator-(difference_type n) const{return iterator(it1_ - n, it2_ - n);}
+            difference_type operator-(const iterator& other) const{return it1_ - other.it1_;}
+
+            bool operator==(const iterator& other) const{return it1_ == other.it1_ || it2_ == other.it2_;}
+            bool operator!=(const iterator& other) const{return !(*this == other);}
+            bool operator<(const iterator& other) const{return it1_ < other.it1_;}
+
+        private:
+            base_iterator1 it1_;
+            base_iterator2 it2_;
+        };
+
+        zip_view(View1 base1, View2 base2):base1_(std::move(base1)), base2_(std::move(base2)){}
+
+        iterator begin(){return iterator(std::begin(base1_), std::begin(base2_));}
+
+        iterator end()
+        {
+            if constexpr(k_random_access)
+            {
+                auto size1 = std::end(base1_) - std::begin(base1_);
+                auto size2 = std::end(base2_) - std::begin(base2_);
+                auto n = size1 < size2 ? size1 : size2;
+                return iterator(std::begin(base1_) + n, std::begin(base2_) + n);
+            }
+            else
+            {
+                return iterator(std::end(base1_), std::end(base2_));
+            }
+        }
+
+    private:
+        View1 base1_;
+        View2 base2_;
+    };
+
+    //---------------------------------------------------------------
+    //chunk
+
+    template<typename View>
+    class chunk_view{
+    public:
+        using base_iterator = range_iterator_t<View>;
+        using difference_type = typename iterator_trait<base_iterator>::difference_type;
+
+        //yields subranges of count elements, the last one may be shorter.
+        //over random access ranges chunk k always starts at begin + k * count,
+        //which keeps every jump O(1)
+        class iterator{
+        public:
+            using iterator_category = typename std::conditional<is_random_access_iterator<base_iterator>::value,
+                random_access_iterator_tag, weaker_category_t<iterator_category_t<base_iterator>, forward_iterator_tag>>::type;
+            using value_type = subrange<base_iterator>;
+            using reference = subrange<base_iterator>;
+            using difference_type = typename iterator_trait<base_iterator>::difference_type;
+            using pointer = void;
+
+            iterator():first_(), cur_(), next_(), last_(), count_(1){}
+            iterator(base_iterator first, base_iterator cur, base_iterator last, difference_type count):
+            first_(first), cur_(cur), next_(cur), last_(last), count_(count)
+            {
+                next_ = chunk_end(cur_);
+            }
+
+            reference operator*() const{return reference(cur_, next_);}
+            reference operator[](difference_type n) const{return *(*this + n);}
+
+            iterator& operator++()
+            {
+                cur_ = next_;
+                next_ = chunk_end(cur_);
+                return *this;
+            }
+            iterator operator++(int){iterator tmp = *this; ++*this; return tmp;}
+            iterator& operator--(){return *this -= 1;}
+            iterator operator--(int){iterator tmp = *this; --*this; return tmp;}
+
+            iterator& operator+=(difference_type n)
+            {
+                difference_type size = last_ - first_;
+                difference_type pos = (index() + n) * count_;
+                cur_ = first_ + (pos < size ? pos : size);
+                next_ = chunk_end(cur_);
+                return *this;
+            }
+            iterator& operator-=(difference_type n){return *this += -n;}
+            iterator operator+(difference_type n) const{iterator tmp = *this; return tmp += n;}
+            iterator operator-(difference_type n) const{iterator tmp = *this; return tmp -= n;}
+            difference_type operator-(const iterator& other) const{return index() - other.index();}
+
+            bool operator==(const iterator& other) const{return cur_ == other.cur_;}
+            bool operator!=(const iterator& other) const{return cur_ != other.cur_;}
+            bool operator<(const iterator& other) const{return cur_ < other.cur_;}
+
+        private:
+            //index of the chunk cur_ starts, the end counts as one past the last chunk
+            difference_type index() const{return ((cur_ - first_) + count_ - 1) / count_;}
+
+            base_iterator chunk_end(base_iterator it) const
+            {
+                if constexpr(is_random_access_iterator<base_iterator>::value)
+                {
+                    return it + (count_ < last_ - it ? count_ : last_ - it);
+                }
+                else
+                {
+                    for(difference_type n = count_; n > 0 && it != last_; n--)
+                    {
+                        ++it;
+                    }
+                    return it;
+                }
+            }
+
+            base_iterator first_;
+            base_iterator cur_;
+            base_iterator next_;
+            base_iterator last_;
+            difference_type count_;
+        };
+
+        chunk_view(View base, difference_type count):base_(std::move(base)), count_(count){}
+
+        iterator begin(){return iterator(std::begin(base_), std::begin(base_), std::end(base_), count_);}
+        iterator end(){return iterator(std::begin(base_), std::end(base_), std::end(base_), count_);}
+
+    private:
+        View base_;
+        difference_type count_;
+    };
+
+    //---------------------------------------------------------------
+    //pipe syntax: range | views::filter(pred) | views::take(n)
+
+    namespace views{
+        template<typename Adaptor>
+        struct view_closure{
+            Adaptor adaptor;
+        };
+
+        template<typename Adaptor>
+        view_closure<Adaptor> make_view_closure(Adaptor adaptor)
+        {
+            return view_closure<Adaptor>{std::move(adaptor)};
+        }
+
+        template<typename Range, typename Adaptor>
+        auto operator|(Range&& range, const view_closure<Adaptor>& closure)
+        {
+            return closure.adaptor(std::forward<Range>(range));
+        }
+
+        //a temporary closure hands over whatever it owns instead of copying it
+        template<typename Range, typename Adaptor>
+        auto operator|(Range&& range, view_closure<Adaptor>&& closure)
+        {
+            return std::move(closure.adaptor)(std::forward<Range>(range));
+        }
+
+        template<typename Func>
+        auto transform(Func func)
+        {
+            return make_view_closure([func](auto&& range){
+                using Range = decltype(range);
+                return transform_view<all_t<Range>, Func>(all(std::forward<Range>(range)), func);
+            });
+        }
+
+        template<typename Pred>
+        auto filter(Pred pred)
+        {
+            return make_view_closure([pred](auto&& range){
+                using Range = decltype(range);
+                return filter_view<all_t<Range>, Pred>(all(std::forward<Range>(range)), pred);
+            });
+        }
+
+        inline auto take(ptrdiff_t count)
+        {
+            return make_view_closure([count](auto&& range){
+                using Range = decltype(range);
+                return take_view<all_t<Range>>(all(std::forward<Range>(range)), count);
+            });
+        }
+
+        inline auto drop(ptrdiff_t count)
+        {
+            return make_view_closure([count](auto&& range){
+                using Range = decltype(range);
+                return drop_view<all_t<Range>>(all(std::forward<Range>(range)), count);
+            });
+        }
+
+        inline auto chunk(ptrdiff_t count)
+        {
+            return make_view_closure([count](auto&& range){
+                using Range = decltype(range);
+                return chunk_view<all_t<Range>>(all(std::forward<Range>(range)), count);
+            });
+        }
+
+        template<typename Range1, typename Range2>
+        auto zip(Range1&& range1, Range2&& range2)
+        {
+            return zip_view<all_t<Range1>, all_t<Range2>>(all(std::forward<Range1>(range1)), all(std::forward<Range2>(range2)));
+        }
+
+        //holds the second range of range1 | zip(range2), an owned range is
+        //copied only when the closure is reused
+        template<typename View2>
+        struct zip_adaptor{
+            View2 base2;
+
+            template<typename Range1>
+            auto operator()(Range1&& range1) const&
+            {
+                return zip_view<all_t<Range1>, View2>(all(std::forward<Range1>(range1)), base2);
+            }
+
+            template<typename Range1>
+            auto operator()(Range1&& range1) &&
+            {
+                return zip_view<all_t<Range1>, View2>(all(std::forward<Range1>(range1)), std::move(base2));
+            }
+        };
+
+        //range1 | zip(range2)
+        template<typename Range2>
+        auto zip(Range2&& range2)
+        {
+            return make_view_closure(zip_adaptor<all_t<Range2>>{all(std::forward<Range2>(range2))});
+        }
+    }
+}
+
+#endif //TINYSTL_RANGES_H
@@ -1,6 +1,9 @@
 #ifndef TINYSTL_SHARED_PTR_H
 #define TINYSTL_SHARED_PTR_H
 
+#include <cstddef>
+
+#include "compressed_pair.h"
 #include "deleter.h"
 
 namespace tinystl{
@@ -12,15 +15,17 @@ namespace tinystl{
 
     template<typename T, typename DeleterType = default_delete<T>>
     struct shared_ptr_control_block: public smart_ptr_control_block{
-        shared_ptr_control_block():ptr(nullptr){}
-        shared_ptr_control_block(T* p): ptr(p){ref_count = 1;}
+        shared_ptr_control_block():storage(nullptr, DeleterType()){}
+        shared_ptr_control_block(T* p): storage(p, DeleterType()){ref_count = 1;}
         void Delete() override
         {
-            deleter(ptr);
-            ptr = nullptr;
+            deleter()(ptr());
+            ptr() = nullptr;
         }
-        DeleterType deleter;
-        T* ptr;
+        inline T*& ptr() noexcept{return storage.first();}
+        inline DeleterType& deleter() noexcept{return storage.second();}
+        //a stateless deleter adds nothing to the block
+        compressed_pair<T*, DeleterType> storage;
     };
     template<typename T, typename U>
     class weak_ptr;
@@ -45,7 +50,7 @@ namespace tinystl{
 
         inline pointer get() const noexcept{return data_;}
 
-        inline Deleter& get_deleter() const noexcept {return cbk_->deleter;}
+        inline Deleter& get_deleter() const noexcept {return cbk_->deleter();}
 
         inline bool unique() const noexcept{return use_count() == 1;}
 
@@ -66,7 +71,7 @@ namespace tinystl{
         template<typename U, typename...VARS> 
         friend shared_ptr<U> make_shared(VARS... );
     private:
-        template<typename U, typename T>
+        template<typename U, typename D>
         friend class weak_ptr;
 
         pointer data_;
@@ -124,7 +129,7 @@ namespace tinystl{
             }
             else
             {
-                this->data_ = cbk->ptr;
+                this->data_ = cbk->ptr();
                 ++(this->cbk_->ref_count);
             }
         }
@@ -179,7 +184,6 @@ namespace tinystl{
     {
         if( this->cbk_ != nullptr && --this->cbk_->ref_count == 0)
         {
-            std::cout << "shared ptr des\n"; 
             this->cbk_->Delete();
             if(this->cbk_->weak_count == 0)
             {
@@ -1,6 +1,68 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <forward_list>
 #include <iostream>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "algorithm.h"
+#include "coroutine.h"
+#include "flat_map.h"
 #include "functional.h"
+#include "lock_free_stack.h"
 #include "memory.h"
+#include "ranges.h"
+
+//stateless deleters take no space
+static_assert(sizeof(tinystl::unique_ptr<int>) == sizeof(int*), "unique_ptr is pointer sized");
+static_assert(sizeof(tinystl::shared_ptr_control_block<int>) ==
+    sizeof(tinystl::smart_ptr_control_block) + sizeof(int*), "deleter adds nothing to the control block");
+
+static int failures = 0;
+
+//asserts vanish in release builds, so failures are counted and reported here
+void check(bool ok, const char* what)
+{
+    if (!ok)
+    {
+        std::cout << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+//a capture-less lambda adds nothing to function's type erased storage
+using int_function = tinystl::function<int(int)>;
+inline auto stateless_twice = [](int x) { return x * 2; };
+static_assert(sizeof(int_function::callable_impl<decltype(stateless_twice)>) == sizeof(void*),
+    "stateless callable_impl is just the vtable pointer");
+static_assert(std::is_convertible<decltype(stateless_twice), int_function>::value, "lambdas convert to function");
+static_assert(!std::is_convertible<int, int_function>::value, "non callables do not convert to function");
+static_assert(!std::is_convertible<void (*)(), int_function>::value, "mismatched signatures do not convert to function");
+
+//iterator categories of views over a std::vector
+template<typename View>
+using view_iterator = decltype(std::declval<View&>().begin());
+
+template<typename Closure>
+using vector_view_iterator = view_iterator<decltype(std::declval<std::vector<int>&>() | std::declval<Closure>())>;
+
+static_assert(tinystl::is_random_access_iterator<vector_view_iterator<decltype(tinystl::views::take(1))>>::value,
+    "take keeps random access");
+static_assert(tinystl::is_random_access_iterator<vector_view_iterator<decltype(tinystl::views::drop(1))>>::value,
+    "drop keeps random access");
+static_assert(tinystl::is_random_access_iterator<vector_view_iterator<decltype(tinystl::views::chunk(1))>>::value,
+    "chunk keeps random access");
+static_assert(tinystl::is_random_access_iterator<view_iterator<decltype(tinystl::views::zip(
+    std::declval<std::vector<int>&>(), std::declval<std::vector<int>&>()))>>::value, "zip keeps random access");
+static_assert(std::is_same<typename tinystl::iterator_trait<vector_view_iterator<decltype(tinystl::views::filter(
+    std::declval<bool (*)(int)>()))>>::iterator_category, tinystl::bidirectional_iterator_tag>::value,
+    "filter is at most bidirectional");
 
 tinystl::weak_ptr<int> gw;
 
@@ -18,6 +80,434 @@ void observe()
     std::cout << "\n";
 }
 
+std::vector<int> random_ints(size_t n, int range)
+{
+    std::mt19937 rng(static_cast<unsigned>(n));
+    std::vector<int> v(n);
+    for (int& x : v)
+    {
+        x = static_cast<int>(rng() % (2 * range)) - range;
+    }
+    return v;
+}
+
+//keys repeat a lot so stability is visible, the second member is the input position
+std::vector<std::pair<int, int>> random_pairs(size_t n)
+{
+    std::vector<int> keys = random_ints(n, 8);
+    std::vector<std::pair<int, int>> v(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        v[i] = {keys[i], static_cast<int>(i)};
+    }
+    return v;
+}
+
+bool same_bits(const std::vector<double>& a, const std::vector<double>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i] != b[i] || std::signbit(a[i]) != std::signbit(b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_sort()
+{
+    auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    auto greater = [](int a, int b) { return a > b; };
+
+    //around the insertion sort and radix sort cut overs
+    const size_t sizes[] = {0, 1, 2, 23, 24, 25, 100, 255, 256, 257, 1000, 5000};
+    for (size_t n : sizes)
+    {
+        std::vector<int> input = random_ints(n, 1000);
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int> v = input;
+        tinystl::sort(v.begin(), v.end());
+        check(v == expected, "sort of signed ints");
+
+        v = input;
+        tinystl::sort(v.begin(), v.end(), greater);
+        check(std::equal(v.begin(), v.end(), expected.rbegin()), "sort with a comparator");
+
+        v = input;
+        tinystl::stable_sort(v.begin(), v.end());
+        check(v == expected, "stable_sort of signed ints");
+
+        std::list<int> list(input.begin(), input.end());
+        tinystl::sort(list.begin(), list.end());
+        check(std::vector<int>(list.begin(), list.end()) == expected, "sort of a bidirectional range");
+
+        std::forward_list<int> forward(input.begin(), input.end());
+        tinystl::stable_sort(forward.begin(), forward.end());
+        check(std::vector<int>(forward.begin(), forward.end()) == expected, "stable_sort of a forward range");
+
+        size_t k = n / 3;
+        v = input;
+        tinystl::partial_sort(v.begin(), v.begin() + k, v.end());
+        check(std::equal(v.begin(), v.begin() + k, expected.begin()), "partial_sort prefix");
+        list.assign(input.begin(), input.end());
+        tinystl::partial_sort(list.begin(), std::next(list.begin(), k), list.end());
+        check(std::equal(list.begin(), std::next(list.begin(), k), expected.begin()), "partial_sort prefix of a list");
+
+        std::vector<std::pair<int, int>> pairs = random_pairs(n);
+        std::vector<std::pair<int, int>> stable = pairs;
+        std::stable_sort(stable.begin(), stable.end(), by_key);
+        std::vector<std::pair<int, int>> p = pairs;
+        tinystl::stable_sort(p.begin(), p.end(), by_key);
+        check(p == stable, "stable_sort keeps equal keys in order");
+        std::list<std::pair<int, int>> pair_list(pairs.begin(), pairs.end());
+        tinystl::stable_sort(pair_list.begin(), pair_list.end(), by_key);
+        check(std::equal(pair_list.begin(), pair_list.end(), stable.begin()), "stable_sort of a list keeps order");
+
+        //signed zeros compare equal, the radix path must not split them
+        std::vector<double> doubles(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            doubles[i] = input[i] % 3 == 0 ? (input[i] < 0 ? -0.0 : 0.0) : input[i] / 7.0;
+        }
+        std::vector<double> stable_doubles = doubles;
+        std::stable_sort(stable_doubles.begin(), stable_doubles.end());
+        std::vector<double> d = doubles;
+        tinystl::stable_sort(d.begin(), d.end());
+        check(same_bits(d, stable_doubles), "stable_sort of doubles with signed zeros");
+        d = doubles;
+        tinystl::sort(d.begin(), d.end());
+        check(std::is_sorted(d.begin(), d.end()) && std::is_permutation(d.begin(), d.end(), doubles.begin()),
+            "sort of doubles");
+    }
+
+    //large enough to be split across threads
+    const size_t n = 200000;
+    std::vector<int> input = random_ints(n, 1 << 20);
+    std::vector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+    std::vector<int> v = input;
+    tinystl::parallel_sort(v.begin(), v.end());
+    check(v == expected, "parallel_sort");
+    v = input;
+    tinystl::parallel_sort(v.begin(), v.end(), greater);
+    check(std::equal(v.begin(), v.end(), expected.rbegin()), "parallel_sort with a comparator");
+
+    std::vector<std::pair<int, int>> pairs = random_pairs(n);
+    std::vector<std::pair<int, int>> stable = pairs;
+    std::stable_sort(stable.begin(), stable.end(), by_key);
+    tinystl::parallel_stable_sort(pairs.begin(), pairs.end(), by_key);
+    check(pairs == stable, "parallel_stable_sort keeps equal keys in order");
+}
+
+void test_flat_set()
+{
+    tinystl::FlatSet<int> set{5, 1, 4, 1, 3, 5, 2};
+    check(set.size() == 5, "FlatSet drops duplicates");
+    check(*set.begin() == 1 && *(set.end() - 1) == 5, "FlatSet is sorted");
+    check(set.contains(3) && !set.contains(6), "FlatSet::contains");
+    check(set.find(6) == set.end(), "FlatSet::find missing key");
+    check(*set.lower_bound(3) == 3 && *set.upper_bound(3) == 4, "FlatSet bounds");
+    check(set.lower_bound(0) == set.begin() && set.upper_bound(5) == set.end(), "FlatSet bounds at the ends");
+
+    check(set.insert(0).second && !set.insert(4).second, "FlatSet::insert");
+    check(*set.begin() == 0 && set.size() == 6, "FlatSet::insert keeps order");
+    check(set.erase(4) == 1 && set.erase(4) == 0 && !set.contains(4), "FlatSet::erase");
+}
+
+void test_flat_map()
+{
+    std::vector<std::pair<int, std::string>> input{{3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}, {1, "y"}};
+    tinystl::FlatMap<int, std::string> map(input.begin(), input.end());
+    check(map.size() == 3, "FlatMap drops duplicates");
+    check(map.at(1) == "a" && map.at(3) == "c", "FlatMap keeps the first duplicate");
+
+    check(map.find(2).value() == "b" && map.find(4) == map.end(), "FlatMap::find");
+    check(map.lower_bound(2).key() == 2 && map.upper_bound(2).key() == 3, "FlatMap bounds");
+    check(map.upper_bound(3) == map.end(), "FlatMap::upper_bound past the last key");
+
+    bool thrown = false;
+    try
+    {
+        map.at(4);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    check(thrown, "FlatMap::at throws on a missing key");
+
+    check(map.insert(0, "z").second && !map.insert(2, "w").second, "FlatMap::insert");
+    check(map.at(0) == "z" && map.at(2) == "b", "FlatMap::insert keeps existing values");
+    map[2] = "B";
+    check(map[5].empty() && map.size() == 5, "FlatMap::operator[] inserts");
+    check(map.at(2) == "B", "FlatMap::operator[] updates");
+    check(map.erase(0) == 1 && map.erase(0) == 0 && !map.contains(0), "FlatMap::erase");
+
+    //proxy iterator
+    std::string keys, values;
+    for (auto entry : map)
+    {
+        keys += std::to_string(entry.first);
+        values += entry.second;
+    }
+    check(keys == "1235" && values == "aBc", "FlatMap iteration");
+    auto it = map.begin();
+    it->second = "A";
+    check((it + 3).key() == 5 && map.end() - it == 4 && map.at(1) == "A", "FlatMap iterator arithmetic");
+    const tinystl::FlatMap<int, std::string>& cmap = map;
+    tinystl::FlatMap<int, std::string>::const_iterator cit = map.begin();
+    check(cit == cmap.begin() && cit[2].second == "c", "FlatMap const_iterator");
+}
+
+//counts copies to check that views move rvalue ranges in
+struct copy_counter
+{
+    static int copies;
+    int value;
+    copy_counter(int v) : value(v) {}
+    copy_counter(const copy_counter& other) : value(other.value) { ++copies; }
+    copy_counter(copy_counter&&) = default;
+};
+int copy_counter::copies = 0;
+
+void test_ranges()
+{
+    std::vector<int> v{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::vector<int> out;
+    for (int x : v | tinystl::views::filter([](int x) { return x % 2 == 0; })
+                   | tinystl::views::transform([](int x) { return x * x; })
+                   | tinystl::views::take(3))
+    {
+        out.push_back(x);
+    }
+    check(out == std::vector<int>{4, 16, 36}, "filter | transform | take");
+
+    auto dropped = v | tinystl::views::drop(7);
+    check(tinystl::distance(dropped.begin(), dropped.end()) == 3 && *dropped.begin() == 8, "drop");
+    auto chunks = v | tinystl::views::chunk(4);
+    auto last_chunk = chunks.begin();
+    tinystl::advance(last_chunk, 2);
+    check(tinystl::distance(chunks.begin(), chunks.end()) == 3 && (*last_chunk).size() == 2, "chunk");
+
+    std::vector<copy_counter> counted;
+    counted.reserve(3);
+    for (int i = 0; i < 3; i++)
+    {
+        counted.emplace_back(i);
+    }
+    copy_counter::copies = 0;
+    int sum = 0;
+    for (auto pair : v | tinystl::views::zip(std::move(counted)))
+    {
+        sum += pair.first * pair.second.value;
+    }
+    check(sum == 1 * 0 + 2 * 1 + 3 * 2, "zip stops at the shorter range");
+    check(copy_counter::copies == 0, "zip moves an rvalue range in");
+}
+
+tinystl::generator<int> iota(int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        co_yield i;
+    }
+}
+
+tinystl::generator<int> throws_after(int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        co_yield i;
+    }
+    throw std::runtime_error("generator");
+}
+
+tinystl::task<int> answer()
+{
+    co_return 42;
+}
+
+tinystl::task<void> add_answer(int& total)
+{
+    total += co_await answer();
+}
+
+tinystl::task<int> add_twice()
+{
+    int total = 0;
+    co_await add_answer(total);
+    co_await add_answer(total);
+    co_return total;
+}
+
+tinystl::task<int> fails()
+{
+    throw std::runtime_error("task");
+    co_return 0;
+}
+
+tinystl::task<int> rethrows()
+{
+    co_return co_await fails() + 1;
+}
+
+//suspends and resumes the awaiting coroutine on a new thread
+struct resume_on_new_thread
+{
+    std::thread& thread;
+    bool await_ready() noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { thread = std::thread([handle] { handle.resume(); }); }
+    void await_resume() noexcept {}
+};
+
+tinystl::task<std::thread::id> switch_thread(std::thread& thread)
+{
+    co_await resume_on_new_thread{thread};
+    co_return std::this_thread::get_id();
+}
+
+void test_coroutine()
+{
+    std::vector<int> values;
+    for (int x : iota(5))
+    {
+        values.push_back(x);
+    }
+    check(values == std::vector<int>{0, 1, 2, 3, 4}, "generator iteration");
+
+    values.clear();
+    for (int x : iota(100) | tinystl::views::filter([](int x) { return x % 3 == 0; }) | tinystl::views::take(4))
+    {
+        values.push_back(x);
+    }
+    check(values == std::vector<int>{0, 3, 6, 9}, "generator | filter | take");
+
+    values.clear();
+    bool thrown = false;
+    try
+    {
+        for (int x : throws_after(2))
+        {
+            values.push_back(x);
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    check(thrown && values.size() == 2, "generator exceptions reach the caller");
+
+    check(tinystl::sync_wait(add_twice()) == 84, "task<int> and task<void> await each other");
+
+    thrown = false;
+    try
+    {
+        tinystl::sync_wait(rethrows());
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    check(thrown, "task exceptions propagate through sync_wait");
+
+    std::thread thread;
+    std::thread::id resumed_on = tinystl::sync_wait(switch_thread(thread));
+    thread.join();
+    check(resumed_on != std::this_thread::get_id(), "sync_wait waits for a task resumed on another thread");
+}
+
+void test_lock_free_stack()
+{
+    tinystl::lock_free_stack<std::string> stack;
+    std::string value;
+    check(stack.empty() && !stack.pop(value), "lock_free_stack starts empty");
+    stack.push("a");
+    stack.push("b");
+    stack.push("c");
+    std::string seen;
+    stack.for_each([&](const std::string& s) { seen += s; });
+    check(seen == "cba", "lock_free_stack::for_each walks from the top");
+    check(stack.pop(value) && value == "c", "lock_free_stack::pop");
+    check(stack.pop(value) && value == "b" && !stack.empty(), "lock_free_stack::pop again");
+}
+
+static int epoch_deletes = 0;
+
+struct counting_delete
+{
+    void operator()(int* p)
+    {
+        ++epoch_deletes;
+        delete p;
+    }
+};
+
+void test_epoch()
+{
+    tinystl::epoch_domain& domain = tinystl::epoch_domain::global();
+    //drain whatever earlier tests retired
+    domain.collect();
+    domain.collect();
+
+    domain.retire<int, counting_delete>(new int(1));
+    {
+        //a pinned thread holds the epoch back
+        tinystl::epoch_guard guard;
+        domain.collect();
+        check(!domain.collect() && epoch_deletes == 0, "epoch_guard blocks reclamation");
+    }
+    check(epoch_deletes == 0, "retired node survives until the epoch moves");
+    uint64_t epoch = domain.epoch();
+    check(domain.collect() && domain.collect() && domain.epoch() == epoch + 2, "collect advances the epoch");
+    check(epoch_deletes == 1, "retired node is deleted two epochs later");
+}
+
+void test_epoch_stalled_reader()
+{
+    tinystl::epoch_domain& domain = tinystl::epoch_domain::global();
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&] {
+        tinystl::epoch_guard guard;
+        pinned = true;
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned)
+    {
+        std::this_thread::yield();
+    }
+
+    //nothing can be freed while the reader is pinned, retire must not rescan
+    //the growing backlog every time
+    const int n = 100000;
+    epoch_deletes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+    {
+        domain.retire<int, counting_delete>(new int(i));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    check(epoch_deletes == 0, "a pinned reader blocks reclamation");
+    check(elapsed.count() < 1.0, "retire stays cheap while a reader is pinned");
+
+    release = true;
+    reader.join();
+    domain.collect();
+    domain.collect();
+    domain.collect();
+    check(epoch_deletes == n, "the backlog is freed once the reader leaves");
+}
+
 int main(int argc, char **argv)
 {
     {
@@ -27,5 +517,17 @@ int main(int argc, char **argv)
         observe();
     }
     observe();
-    return 0;
+
+    tinystl::function<int(int)> twice = [](int x){return x * 2;};
+    std::cout << "twice(21) = " << twice(21) << "\n";
+
+    test_sort();
+    test_flat_set();
+    test_flat_map();
+    test_ranges();
+    test_coroutine();
+    test_lock_free_stack();
+    test_epoch();
+    test_epoch_stalled_reader();
+    return failures == 0 ? 0 : 1;
 }
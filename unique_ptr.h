@@ -1,6 +1,7 @@
 #ifndef TINYSTL_UNIQUE_PTR_H
 #define TINYSTL_UNIQUE_PTR_H
 
+#include "compressed_pair.h"
 #include "deleter.h"
 
 namespace tinystl{
@@ -20,12 +21,13 @@ namespace tinystl{
         unique_ptr& operator=(const unique_ptr& p) = delete;
         unique_ptr& operator=(unique_ptr&& p);
 
-        inline pointer get() const{return data_;}
-        inline Deleter& get_deleter() const noexcept {return deleter_;}
+        inline pointer get() const{return storage_.first();}
+        inline Deleter& get_deleter() noexcept {return storage_.second();}
+        inline const Deleter& get_deleter() const noexcept {return storage_.second();}
 
-        value_type& operator*(){return *data_;}
-        pointer operator->() const{return data_;}
-        operator bool() const{return data_ != nullptr;}
+        value_type& operator*(){return *storage_.first();}
+        pointer operator->() const{return storage_.first();}
+        operator bool() const{return storage_.first() != nullptr;}
 
         ~unique_ptr();
 
@@ -33,45 +35,46 @@ namespace tinystl{
         friend unique_ptr<U> make_unique(VARS... );
         
     private:
-        pointer data_;
-        Deleter deleter_;
+        //a stateless deleter takes no space, unique_ptr stays pointer sized
+        compressed_pair<pointer, Deleter> storage_;
     };
 
     template<typename T, typename... VARS>
     unique_ptr<T> make_unique(VARS... vars)
     {
         unique_ptr<T> p;
-        p.data_ = new T(vars...);
+        p.storage_.first() = new T(vars...);
         return p;
     }
 
     template<typename T, typename Deleter>
-    unique_ptr<T, Deleter>::unique_ptr():data_(nullptr), deleter_(Deleter()){}
+    unique_ptr<T, Deleter>::unique_ptr():storage_(nullptr, Deleter()){}
 
     template<typename T, typename Deleter>
     unique_ptr<T, Deleter>::unique_ptr(const typename unique_ptr<T, Deleter>::pointer p):
-    data_(p), deleter_(Deleter()){}
+    storage_(p, Deleter()){}
 
     template<typename T, typename Deleter>
-    unique_ptr<T, Deleter>::unique_ptr::unique_ptr(unique_ptr&& p )
+    unique_ptr<T, Deleter>::unique_ptr::unique_ptr(unique_ptr&& p ):
+    storage_(p.storage_.first(), std::move(p.storage_.second()))
     {
-        this->data_ = p.data_;
-        p.data_  = nullptr;
+        p.storage_.first() = nullptr;
     }
 
     template<typename T, typename Deleter>
     unique_ptr<T, Deleter>& unique_ptr<T, Deleter>::operator=(unique_ptr&& p)
     {
-        deleter_(data_);
-        this->data_ = p.data_;
-        p.data_ = nullptr;
+        storage_.second()(storage_.first());
+        storage_.first() = p.storage_.first();
+        storage_.second() = std::move(p.storage_.second());
+        p.storage_.first() = nullptr;
         return *this;
     }
 
     template<typename T, typename Deleter>
     unique_ptr<T, Deleter>::unique_ptr::~unique_ptr()
     {
-        deleter_(data_);
+        storage_.second()(storage_.first());
     }
 
     